@@ -0,0 +1,571 @@
+// Author: Dennis Yakovlev
+
+// Benchmark of BigUnsigned arithmetic.
+// Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+//
+// bench_bigint                  tuning sweeps and the operation sweep as tables
+// bench_bigint --json FILE      tuning sweeps, operation sweep written to FILE as JSON
+// bench_bigint --baseline FILE  tuning sweeps, operation sweep compared against FILE, see baseline_bigint.json
+//
+// The tuning sweeps also check every algorithm against the others, so they run in
+// every mode and the exit code is non zero if any result differs.
+
+#include <algorithm>
+#include <BigInt.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <prob_utils.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Random number with exactly \p n digits.
+ *
+ */
+_limb_vec random_limbs(std::mt19937_64& gen, std::size_t n) {
+
+    _limb_vec res(n);
+    for (auto& limb : res) {
+        limb = gen() & BASE_MASK;
+    }
+    res.back() |= 1;
+
+    return res;
+
+}
+
+/**
+ * @brief Average nanoseconds per call of \p func, running it for at least \p min_ns.
+ *
+ */
+double time_ns(const std::function<void()>& func, double min_ns = 2e8) {
+
+    using clock = std::chrono::steady_clock;
+
+    std::size_t iters = 1;
+    while (true) {
+        auto start = clock::now();
+        for (std::size_t i = 0; i != iters; ++i) {
+            func();
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        if (elapsed >= min_ns) {
+            return elapsed / static_cast<double>(iters);
+        }
+        iters *= 2;
+    }
+
+}
+
+/**
+ * @brief Time a balanced n x n digit multiplication with the given thresholds.
+ *
+ */
+double bench_mul(const _limb_vec& a, const _limb_vec& b, _limb_vec* res, std::size_t kara, std::size_t toom) {
+
+    const auto kara_old = karatsuba_threshold;
+    const auto toom_old = toom3_threshold;
+    karatsuba_threshold = kara;
+    toom3_threshold = toom;
+
+    double ns = time_ns([&]() {
+        _limbs_mul(res->data(), a.data(), a.size(), b.data(), b.size());
+    });
+
+    karatsuba_threshold = kara_old;
+    toom3_threshold = toom_old;
+
+    return ns;
+
+}
+
+/**
+ * @brief Multiplication algorithm sweep. Shows at what size each algorithm
+ *        starts to win, which is what \p karatsuba_threshold and \p toom3_threshold
+ *        should be set to.
+ *
+ * @return number of mismatches
+ */
+int sweep_mul() {
+
+    int mismatches = 0;
+
+    constexpr auto never = std::numeric_limits<std::size_t>::max();
+
+    std::mt19937_64 gen(42);
+
+    std::printf("multiplication (ns per op)\n");
+    std::printf("%8s %14s %14s %14s %14s\n", "digits", "schoolbook", "karatsuba", "toom3", "auto");
+
+    for (std::size_t n = 8; n <= 4096; n *= 2) {
+        auto a = random_limbs(gen, n);
+        auto b = random_limbs(gen, n);
+
+        _limb_vec school(2 * n), kara(2 * n), toom(2 * n), chosen(2 * n);
+
+        double t_school = bench_mul(a, b, &school, never, never);
+        double t_kara = bench_mul(a, b, &kara, karatsuba_threshold, never);
+        double t_toom = bench_mul(a, b, &toom, karatsuba_threshold, 3 * karatsuba_threshold);
+        double t_auto = bench_mul(a, b, &chosen, karatsuba_threshold, toom3_threshold);
+
+        if (school != kara || school != toom || school != chosen) {
+            std::printf("mismatch at %zu digits\n", n);
+            ++mismatches;
+        }
+
+        std::printf("%8zu %14.0f %14.0f %14.0f %14.0f\n", n, t_school, t_kara, t_toom, t_auto);
+    }
+
+    std::printf("\n");
+
+    return mismatches;
+
+}
+
+/**
+ * @brief Squaring sweep against multiplying two equal numbers. Shows at what size
+ *        Karatsuba squaring starts to win, which is what \p karatsuba_sqr_threshold
+ *        should be set to.
+ *
+ * @return number of mismatches
+ */
+int sweep_sqr() {
+
+    int mismatches = 0;
+
+    constexpr auto never = std::numeric_limits<std::size_t>::max();
+
+    std::mt19937_64 gen(23);
+
+    const auto sqr_old = karatsuba_sqr_threshold;
+
+    std::printf("squaring (ns per op)\n");
+    std::printf("%8s %14s %14s %14s %14s\n", "digits", "multiply", "schoolbook", "karatsuba", "auto");
+
+    for (std::size_t n = 16; n <= 1024; n *= 2) {
+        auto a = random_limbs(gen, n);
+        auto copy = a;
+
+        _limb_vec mul(2 * n), school(2 * n), kara(2 * n), chosen(2 * n);
+
+        double t_mul = time_ns([&]() { _limbs_mul(mul.data(), a.data(), n, copy.data(), n); }, 5e7);
+        karatsuba_sqr_threshold = never;
+        double t_school = time_ns([&]() { _limbs_sqr(school.data(), a.data(), n); }, 5e7);
+        karatsuba_sqr_threshold = karatsuba_threshold;
+        double t_kara = time_ns([&]() { _limbs_sqr(kara.data(), a.data(), n); }, 5e7);
+        karatsuba_sqr_threshold = sqr_old;
+        double t_auto = time_ns([&]() { _limbs_sqr(chosen.data(), a.data(), n); }, 5e7);
+
+        if (mul != school || mul != kara || mul != chosen) {
+            std::printf("square mismatch at %zu digits\n", n);
+            ++mismatches;
+        }
+
+        std::printf("%8zu %14.0f %14.0f %14.0f %14.0f\n", n, t_mul, t_school, t_kara, t_auto);
+    }
+
+    std::printf("\n");
+
+    return mismatches;
+
+}
+
+/**
+ * @brief Time every kernel variant this cpu supports against the scalar one,
+ *        checking they give the same results.
+ *
+ * @return number of mismatches
+ */
+int sweep_kernels() {
+
+    int mismatches = 0;
+
+    std::mt19937_64 gen(7);
+
+    const auto supported = _kernels_supported();
+    const auto chosen = _kernels;
+    const auto& scalar = supported.front();
+
+    std::printf("kernels (ns per op), chosen %s\n", chosen.name);
+    std::printf("%8s %8s %12s %12s %12s %12s %12s\n", "variant", "digits", "add_n", "sub_n", "addmul_1", "mul_1", "divrem_1");
+
+    for (std::size_t n : { 16, 256, 4096 }) {
+        auto a = random_limbs(gen, n);
+        auto b = random_limbs(gen, n);
+        const _limb m = gen() & BASE_MASK;
+        const _limb d = (gen() & BASE_MASK) | 1;
+
+        // results of the scalar variant to compare against
+        _limb_vec sum(n), diff(n), prod(n), acc(b), quot(n);
+        _limb carries[4] = { scalar.add_n(sum.data(), a.data(), b.data(), n, 1),
+                             scalar.sub_n(diff.data(), a.data(), b.data(), n, 1),
+                             scalar.addmul_1(acc.data(), a.data(), n, m),
+                             scalar.mul_1(prod.data(), a.data(), n, m) };
+
+        for (const auto& kernels : supported) {
+            _limb_vec r(n), r_acc(b);
+            bool same = kernels.add_n(r.data(), a.data(), b.data(), n, 1) == carries[0] && r == sum;
+            same &= kernels.sub_n(r.data(), a.data(), b.data(), n, 1) == carries[1] && r == diff;
+            same &= kernels.addmul_1(r_acc.data(), a.data(), n, m) == carries[2] && r_acc == acc;
+            same &= kernels.mul_1(r.data(), a.data(), n, m) == carries[3] && r == prod;
+            if (!same) {
+                std::printf("%s differs from scalar at %zu digits\n", kernels.name, n);
+                ++mismatches;
+            }
+
+            double t_add = time_ns([&]() { kernels.add_n(r.data(), a.data(), b.data(), n, 0); }, 5e7);
+            double t_sub = time_ns([&]() { kernels.sub_n(r.data(), a.data(), b.data(), n, 0); }, 5e7);
+            double t_addmul = time_ns([&]() { kernels.addmul_1(r_acc.data(), a.data(), n, m); }, 5e7);
+            double t_mul = time_ns([&]() { kernels.mul_1(r.data(), a.data(), n, m); }, 5e7);
+            std::printf("%8s %8zu %12.0f %12.0f %12.0f %12.0f %12s\n", kernels.name, n, t_add, t_sub, t_addmul, t_mul, "");
+        }
+
+        // division by a digit only has a scalar form, compare against the hardware division
+        _limb rem = _limbs_divrem_1(quot.data(), a.data(), n, d);
+        _limb_vec check(n);
+        _limb rem_check = 0;
+        for (std::size_t i = n; i-- != 0;) {
+            _dlimb cur = (static_cast<_dlimb>(rem_check) << BASE_BIN_LENGTH) | a[i];
+            check[i] = static_cast<_limb>(cur / d);
+            rem_check = static_cast<_limb>(cur % d);
+        }
+        if (rem != rem_check || quot != check) {
+            std::printf("divrem_1 differs at %zu digits\n", n);
+            ++mismatches;
+        }
+
+        double t_hw = time_ns([&]() {
+            _limb r = 0;
+            for (std::size_t i = n; i-- != 0;) {
+                _dlimb cur = (static_cast<_dlimb>(r) << BASE_BIN_LENGTH) | a[i];
+                quot[i] = static_cast<_limb>(cur / d);
+                r = static_cast<_limb>(cur % d);
+            }
+        }, 5e7);
+        double t_inv = time_ns([&]() { _divrem_1_preinv(quot.data(), a.data(), n, d); }, 5e7);
+        std::printf("%8s %8zu %12s %12s %12s %12s %12.0f\n", "div", n, "", "", "", "", t_hw);
+        std::printf("%8s %8zu %12s %12s %12s %12s %12.0f\n", "preinv", n, "", "", "", "", t_inv);
+    }
+
+    std::printf("\n");
+
+    return mismatches;
+
+}
+
+/**
+ * @brief Check the number theoretic transform against schoolbook multiplication,
+ *        including digits of all ones which give the largest coefficients, and
+ *        time it against Toom-3. Shows what \p ntt_threshold should be set to.
+ *
+ * @return number of mismatches
+ */
+int sweep_ntt() {
+
+    int mismatches = 0;
+
+    constexpr auto never = std::numeric_limits<std::size_t>::max();
+
+    std::mt19937_64 gen(13);
+
+    for (std::size_t i = 0; i != 200; ++i) {
+        const std::size_t an = 1 + gen() % 600;
+        const std::size_t bn = 1 + gen() % 600;
+        auto a = random_limbs(gen, an);
+        auto b = i % 2 == 0 ? random_limbs(gen, bn) : _limb_vec(bn, BASE_MASK);
+        if (i % 4 == 3) {
+            std::fill(a.begin(), a.end(), BASE_MASK);
+        }
+
+        _limb_vec school(an + bn), ntt(an + bn), square(2 * an), ntt_square(2 * an);
+        _limbs_mul_basecase(school.data(), a.data(), an, b.data(), bn);
+        _limbs_mul_ntt(ntt.data(), a.data(), an, b.data(), bn);
+        _limbs_mul_basecase(square.data(), a.data(), an, a.data(), an);
+        _limbs_mul_ntt(ntt_square.data(), a.data(), an, a.data(), an);
+
+        if (school != ntt || square != ntt_square) {
+            std::printf("ntt mismatch at %zu x %zu digits\n", an, bn);
+            ++mismatches;
+        }
+    }
+
+    const auto ntt_old = ntt_threshold;
+
+    std::printf("ntt multiplication (ns per op)\n");
+    std::printf("%8s %14s %14s\n", "digits", "toom3", "ntt");
+
+    for (std::size_t n = 1024; n <= 32768; n *= 2) {
+        auto a = random_limbs(gen, n);
+        auto b = random_limbs(gen, n);
+
+        _limb_vec toom(2 * n), ntt(2 * n);
+
+        ntt_threshold = never;
+        double t_toom = time_ns([&]() { _limbs_mul(toom.data(), a.data(), n, b.data(), n); });
+        double t_ntt = time_ns([&]() { _limbs_mul_ntt(ntt.data(), a.data(), n, b.data(), n); });
+        ntt_threshold = ntt_old;
+
+        if (toom != ntt) {
+            std::printf("ntt mismatch at %zu digits\n", n);
+            ++mismatches;
+        }
+
+        std::printf("%8zu %14.0f %14.0f\n", n, t_toom, t_ntt);
+    }
+
+    std::printf("\n");
+
+    return mismatches;
+
+}
+
+/**
+ * @brief Time large multiplications with 1, 2, 4, ... threads, up to at least the
+ *        number of cores. Shows how well \p bigint_threads scales and where
+ *        \p parallel_mul_threshold pays off.
+ *
+ * @return number of mismatches
+ */
+int sweep_threads() {
+
+    int mismatches = 0;
+
+    std::mt19937_64 gen(11);
+
+    const auto threads_old = bigint_threads;
+    const std::size_t cores = std::max(2u, std::thread::hardware_concurrency());
+
+    std::printf("parallel multiplication (ns per op, speedup over 1 thread)\n");
+    std::printf("%8s %8s %14s %8s\n", "digits", "threads", "ns", "speedup");
+
+    for (std::size_t n = 1024; n <= 32768; n *= 4) {
+        auto a = random_limbs(gen, n);
+        auto b = random_limbs(gen, n);
+
+        _limb_vec single(2 * n);
+        double t_single = 0;
+
+        for (std::size_t threads = 1; threads <= cores; threads *= 2) {
+            set_bigint_threads(threads);
+
+            _limb_vec res(2 * n);
+            double t = time_ns([&]() {
+                _limbs_mul(res.data(), a.data(), a.size(), b.data(), b.size());
+            });
+
+            if (threads == 1) {
+                single = res;
+                t_single = t;
+            } else if (res != single) {
+                std::printf("mismatch at %zu digits with %zu threads\n", n, threads);
+                ++mismatches;
+            }
+
+            std::printf("%8zu %8zu %14.0f %8.2f\n", n, threads, t, t_single / t);
+        }
+    }
+
+    set_bigint_threads(threads_old);
+
+    std::printf("\n");
+
+    return mismatches;
+
+}
+
+/**
+ * @brief Random BigUnsigned with exactly \p n digits.
+ *
+ */
+BigUnsigned random_num(std::mt19937_64& gen, std::size_t n) {
+
+    BigUnsigned res(static_cast<BigUnsigned::sz_ty_ull>(0));
+    res.digits = random_limbs(gen, n);
+
+    return res;
+
+}
+
+/**
+ * @brief One measurement of the operation sweep.
+ *
+ */
+struct op_result {
+    std::string op;
+    std::size_t limbs; // digits of the longer operand, of the result for pow and factorial
+    double ns; // per op
+    double allocs; // digit storage allocations reaching the heap per op
+};
+
+/**
+ * @brief Measure \p func, which reports the digits it worked on through \p limbs.
+ *
+ */
+op_result measure_op(const char* op, const std::function<std::size_t()>& func) {
+
+    const std::size_t limbs = func(); // warm up caches such as the powers of 10
+
+    const auto before = bigint_alloc_stats;
+    func();
+    const auto allocs = (bigint_alloc_stats - before).heap;
+
+    const double ns = time_ns([&]() { func(); }, 5e7);
+
+    return {op, limbs, ns, static_cast<double>(allocs)};
+
+}
+
+/**
+ * @brief Time the public BigUnsigned operations over a range of operand sizes.
+ *
+ */
+std::vector<op_result> sweep_ops() {
+
+    std::mt19937_64 gen(17);
+
+    std::vector<op_result> res;
+    BigUnsigned out;
+
+    for (std::size_t n = 1; n <= 4096; n *= 4) {
+        const auto a = random_num(gen, n);
+        const auto b = random_num(gen, n);
+        const auto wide = random_num(gen, 2 * n);
+        const auto base = random_num(gen, 1);
+        const auto exp = BigUnsigned(n, NATIVE{});
+        const auto str = BigUnsigned_10_str(a);
+
+        res.push_back(measure_op("add", [&]() { out = a + b; return n; }));
+        res.push_back(measure_op("sub", [&]() { out = a - b; return n; }));
+        res.push_back(measure_op("mul", [&]() { out = a * b; return n; }));
+        res.push_back(measure_op("div", [&]() { out = wide / b; return 2 * n; }));
+        res.push_back(measure_op("pow", [&]() { out = pow(base, exp); return out.digits.size(); }));
+        res.push_back(measure_op("factorial", [&]() { out = _prob factorial(static_cast<_prob size_t>(4 * n)); return out.digits.size(); }));
+        res.push_back(measure_op("BigUnsigned_10", [&]() { return BigUnsigned_10(a).size() != 0 ? n : 0; }));
+        res.push_back(measure_op("string", [&]() { out = BigUnsigned(str); return out.digits.size(); }));
+        if (n <= DOUBLE_CONVERSION) {
+            res.push_back(measure_op("BigUnsigned_10_dbl", [&]() { return BigUnsigned_10_dbl(a) >= 0 ? n : 0; }));
+        }
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief Write \p results as JSON, one result per line so \p read_json can read it back.
+ *
+ */
+void write_json(std::FILE* file, const std::vector<op_result>& results) {
+
+    std::fprintf(file, "{\n  \"limb_bits\": %u,\n  \"threads\": %zu,\n  \"results\": [\n", BASE_BIN_LENGTH, bigint_threads);
+    for (std::size_t i = 0; i != results.size(); ++i) {
+        const auto& r = results[i];
+        std::fprintf(file, "    {\"op\": \"%s\", \"limbs\": %zu, \"ns_per_op\": %.1f, \"allocs_per_op\": %.1f, \"limbs_per_s\": %.4g}%s\n",
+            r.op.c_str(), r.limbs, r.ns, r.allocs, static_cast<double>(r.limbs) * 1e9 / r.ns, i + 1 == results.size() ? "" : ",");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+}
+
+/**
+ * @brief Read results written by \p write_json. Not a general JSON reader.
+ *
+ */
+std::vector<op_result> read_json(std::FILE* file) {
+
+    std::vector<op_result> res;
+
+    char line[512];
+    while (std::fgets(line, sizeof(line), file)) {
+        char op[64];
+        op_result r;
+        if (std::sscanf(line, " {\"op\": \"%63[^\"]\", \"limbs\": %zu, \"ns_per_op\": %lf, \"allocs_per_op\": %lf",
+                op, &r.limbs, &r.ns, &r.allocs) == 4) {
+            r.op = op;
+            res.push_back(r);
+        }
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief Print \p results, next to \p baseline when it has a matching operation and size.
+ *        Repeated operation and size pairs are matched in order.
+ *
+ */
+void print_ops(const std::vector<op_result>& results, const std::vector<op_result>& baseline) {
+
+    std::printf("operations\n");
+    std::printf("%20s %8s %14s %10s %12s %14s %8s\n", "op", "digits", "ns", "allocs", "digits/s", "baseline ns", "speedup");
+
+    for (auto r = results.cbegin(); r != results.cend(); ++r) {
+        std::printf("%20s %8zu %14.1f %10.1f %12.4g", r->op.c_str(), r->limbs, r->ns, r->allocs, static_cast<double>(r->limbs) * 1e9 / r->ns);
+        auto same = [&](const op_result& o) { return o.op == r->op && o.limbs == r->limbs; };
+        auto seen = std::count_if(results.cbegin(), r, same); // small factorials share a size, pair them in order
+        auto base = std::find_if(baseline.cbegin(), baseline.cend(), same);
+        while (base != baseline.cend() && seen-- != 0) {
+            base = std::find_if(base + 1, baseline.cend(), same);
+        }
+        if (base != baseline.cend()) {
+            std::printf(" %14.1f %8.2f", base->ns, base->ns / r->ns);
+        }
+        std::printf("\n");
+    }
+
+    std::printf("\n");
+
+}
+
+int main(int argc, char** argv) {
+
+    const char* json_path = nullptr;
+    const char* baseline_path = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json_path = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--baseline") == 0) {
+            baseline_path = argv[i + 1];
+        }
+    }
+
+    std::vector<op_result> baseline;
+    if (baseline_path) {
+        std::FILE* file = std::fopen(baseline_path, "r");
+        if (!file) {
+            std::printf("can not open %s\n", baseline_path);
+            return 1;
+        }
+        baseline = read_json(file);
+        std::fclose(file);
+    }
+
+    // exactness checks, run whatever the mode so a wrong product fails the run
+    int mismatches = sweep_kernels();
+    mismatches += sweep_mul();
+    mismatches += sweep_sqr();
+    mismatches += sweep_ntt();
+    mismatches += sweep_threads();
+
+    const auto results = sweep_ops();
+    print_ops(results, baseline);
+
+    if (json_path) {
+        std::FILE* file = std::fopen(json_path, "w");
+        if (!file) {
+            std::printf("can not open %s\n", json_path);
+            return 1;
+        }
+        write_json(file, results);
+        std::fclose(file);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+
+}
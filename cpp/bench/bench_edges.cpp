@@ -0,0 +1,264 @@
+// Author: Dennis Yakovlev
+
+// Benchmark of edge_prob over grid sizes, against the row by row scalar version it replaced.
+// Build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+//
+// bench_edges    table of ns per call for each instruction set, and whether the output
+//                is identical to the reference, then edge_prob_parallel on large grids
+//                with 1, 2, 4, ... threads
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <prob_probability.h>
+#include <prob_simd.h>
+#include <thread>
+#include <vector>
+
+start_probability
+
+/**
+ * @brief edge_prob before the band kernels, the output must stay identical to this.
+ *
+ */
+auto edge_prob_reference(coord_ty end, DOUBLE _) {
+
+    using prob_vec = _prob container_ty<double>;
+
+    prob_vec::size_type size = static_cast<prob_vec::size_type>(1 + (end.first * (end.second + 1)) + ((end.first + 1) * end.second));
+    prob_vec res(size, 100); // container for all percentages
+
+    double remaining_moves = end.first + end.second; // dangerous from size_t to double, might not be enough space in double
+
+    auto res_iter = res.begin();
+    *res_iter = 100;
+    ++res_iter;
+
+    if (end.first == 0 || end.second == 0) {
+        return res;
+    }
+
+    for (size_t i = 0; i != end.first; ++i, ++res_iter) { // first row of horizontal edges
+        *res_iter = *(res_iter - 1) * ((end.first - i) / (remaining_moves - i));
+    }
+
+    for (size_t i = 0; i != end.first + 1; ++i, ++res_iter) { // first row of vertical edges
+        *res_iter = *(res_iter - end.first - 1) * (end.second / (remaining_moves - i));
+    }
+
+    for (size_t i = 0; i != end.second - 1; ++i) {
+
+        --remaining_moves;
+
+        // horizontal
+        *res_iter = *(res_iter - end.first - 1) * (end.first / remaining_moves);
+        ++res_iter;
+        for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) {
+            *res_iter = (*(res_iter - 1) + *(res_iter - end.first - 1)) * ((end.first - j - 1) / (remaining_moves - j - 1));
+        }
+
+        // vertical
+        *res_iter = *(res_iter - (2 * end.first) - 1) * ((end.second - i - 1) / remaining_moves);
+        ++res_iter;
+        for (size_t j = 0; j != end.first; ++j, ++res_iter) {
+            *res_iter = (*(res_iter - end.first - 1) + *(res_iter - (2 * end.first) - 1)) * ((end.second - i - 1) / (remaining_moves - j -1));
+        }
+
+    }
+
+    --remaining_moves;
+    *res_iter = *(res_iter - end.first - 1) * (end.first / remaining_moves);
+    ++res_iter;
+    for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) { // last row of horizontal edges
+        *res_iter = (*(res_iter - 1) + *(res_iter - end.first - 1)) * ((end.first - j - 1) / (remaining_moves - j - 1));
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief edge_prob before the band kernels, the output must stay identical to this.
+ *
+ */
+auto edge_prob_reference(coord_ty end, INT_LEAST64 _) {
+
+    using prob_vec = _prob container_ty<int_least64_t>;
+
+    prob_vec::size_type size = static_cast<prob_vec::size_type>(1 + (end.first * (end.second + 1)) + ((end.first + 1) * end.second));
+    prob_vec res(size, precision10_value); // container for all percentages
+
+    int_least64_t remaining_moves = end.first + end.second;
+
+    auto res_iter = res.begin();
+    *res_iter = precision10_value;
+    ++res_iter;
+
+    if (end.first == 0 || end.second == 0) {
+        return res;
+    }
+
+    for (size_t i = 0; i != end.first; ++i, ++res_iter) { // first row of horizontal edges        
+        *res_iter = (*(res_iter - 1) * ((precision10_value * (end.first - i)) / (remaining_moves - i))) / precision10_value;
+    }
+
+    for (size_t i = 0; i != end.first + 1; ++i, ++res_iter) { // first row of vertical edges
+        *res_iter = (*(res_iter - end.first - 1) * ((precision10_value * end.second) / (remaining_moves - i))) / precision10_value;
+    }
+
+    for (size_t i = 0; i != end.second - 1; ++i) {
+
+        --remaining_moves;
+
+        // horizontal
+        *res_iter = (*(res_iter - end.first - 1) * ((precision10_value * end.first) / remaining_moves)) / precision10_value;
+        ++res_iter;
+        for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) {
+            *res_iter = ((*(res_iter - 1) + *(res_iter - end.first - 1)) * ((precision10_value * (end.first - j - 1)) / (remaining_moves - j - 1))) / precision10_value;
+        }
+
+        // vertical
+        *res_iter = (*(res_iter - (2 * end.first) - 1) * ((precision10_value * (end.second - i - 1)) / remaining_moves)) / precision10_value;
+        ++res_iter;
+        for (size_t j = 0; j != end.first; ++j, ++res_iter) {
+            *res_iter = ((*(res_iter - end.first - 1) + *(res_iter - (2 * end.first) - 1)) * ((precision10_value * (end.second - i - 1)) / (remaining_moves - j -1))) / precision10_value;
+        }
+
+    }
+
+    --remaining_moves;
+    *res_iter = (*(res_iter - end.first - 1) * ((precision10_value * end.first) / remaining_moves)) / precision10_value;
+    ++res_iter;
+    for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) { // last row of horizontal edges
+        *res_iter = ((*(res_iter - 1) + *(res_iter - end.first - 1)) * ((precision10_value * (end.first - j - 1)) / (remaining_moves - j - 1))) / precision10_value;
+    }
+
+    return res;
+
+}
+
+end_probability
+
+/**
+ * @brief Average nanoseconds per call of \p func, running it for at least \p min_ns.
+ *
+ */
+double time_ns(const std::function<void()>& func, double min_ns = 2e8) {
+
+    using clock = std::chrono::steady_clock;
+
+    std::size_t iters = 1;
+    while (true) {
+        auto start = clock::now();
+        for (std::size_t i = 0; i != iters; ++i) {
+            func();
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        if (elapsed >= min_ns) {
+            return elapsed / static_cast<double>(iters);
+        }
+        iters *= 2;
+    }
+
+}
+
+/**
+ * @brief Time \p Tag edge_prob for square grids at every instruction set the cpu has,
+ *        and check the output is bit for bit the reference.
+ *
+ * @return number of mismatches
+ */
+template<typename Tag>
+int sweep_edges(const char* name, Tag tag) {
+
+    const _prob simd_level levels[] = {_prob simd_level::SCALAR, _prob simd_level::AVX2, _prob simd_level::AVX512};
+    const char* level_names[] = {"scalar", "avx2", "avx512"};
+    const auto best = _prob _detect_simd();
+
+    std::printf("edge_prob %s, ns per call\n", name);
+    std::printf("%10s %14s", "grid", "reference");
+    for (std::size_t l = 0; l != 3; ++l) {
+        if (levels[l] <= best) {
+            std::printf(" %14s %8s", level_names[l], "speedup");
+        }
+    }
+    std::printf(" %10s\n", "identical");
+
+    int mismatches = 0;
+    for (_prob size_t n : {10, 20, 50, 100, 200, 500, 1000, 2000}) {
+        const _prob coord_ty end(n, n);
+        const auto reference = _prob edge_prob_reference(end, tag);
+        const double ref_ns = time_ns([&]() { _prob edge_prob_reference(end, tag); });
+
+        std::printf("%5lldx%-4lld %14.0f", n, n, ref_ns);
+        bool identical = true;
+        for (std::size_t l = 0; l != 3; ++l) {
+            if (levels[l] > best) {
+                continue;
+            }
+            _prob set_edge_simd(levels[l]);
+            const auto res = _prob edge_prob(end, tag);
+            identical = identical && res.size() == reference.size() &&
+                        std::memcmp(res.data(), reference.data(), res.size() * sizeof(res[0])) == 0;
+            const double ns = time_ns([&]() { _prob edge_prob(end, tag); });
+            std::printf(" %14.0f %8.2f", ns, ref_ns / ns);
+        }
+        _prob set_edge_simd(best);
+        std::printf(" %10s\n", identical ? "yes" : "NO");
+        mismatches += identical ? 0 : 1;
+    }
+    std::printf("\n");
+
+    return mismatches;
+
+}
+
+/**
+ * @brief Time \p Tag edge_prob_parallel with 1, 2, 4, ... threads, up to at least the
+ *        number of cores, and check the output is bit for bit edge_prob.
+ *
+ * @return number of mismatches
+ */
+template<typename Tag>
+int sweep_threads(const char* name, Tag tag) {
+
+    const auto threads_old = bigint_threads;
+    const std::size_t cores = std::max(2u, std::thread::hardware_concurrency());
+
+    std::printf("edge_prob_parallel %s (ns per call, speedup over edge_prob)\n", name);
+    std::printf("%10s %8s %14s %8s %10s\n", "grid", "threads", "ns", "speedup", "identical");
+
+    int mismatches = 0;
+    for (_prob size_t n : {1000, 2000, 5000}) {
+        const _prob coord_ty end(n, n);
+        const auto sequential = _prob edge_prob(end, tag);
+        const double seq_ns = time_ns([&]() { _prob edge_prob(end, tag); });
+
+        for (std::size_t threads = 1; threads <= cores; threads *= 2) {
+            set_bigint_threads(threads);
+            const auto res = _prob edge_prob_parallel(end, tag);
+            const bool identical = res.size() == sequential.size() &&
+                                   std::memcmp(res.data(), sequential.data(), res.size() * sizeof(res[0])) == 0;
+            const double ns = time_ns([&]() { _prob edge_prob_parallel(end, tag); });
+            std::printf("%5lldx%-4lld %8zu %14.0f %8.2f %10s\n", n, n, threads, ns, seq_ns / ns, identical ? "yes" : "NO");
+            mismatches += identical ? 0 : 1;
+        }
+    }
+    std::printf("\n");
+
+    set_bigint_threads(threads_old);
+
+    return mismatches;
+
+}
+
+int main() {
+
+    int mismatches = sweep_edges("DOUBLE", _prob DOUBLE{}) + sweep_edges("INT_LEAST64", _prob INT_LEAST64{});
+    mismatches += sweep_threads("DOUBLE", _prob DOUBLE{}) + sweep_threads("INT_LEAST64", _prob INT_LEAST64{});
+
+    return mismatches == 0 ? 0 : 1;
+
+}
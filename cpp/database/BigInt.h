@@ -1,756 +1,1314 @@
-// Author: Dennis Yakovlev
-
-// File containing all members relating to BigUnsigned type.
-// Allows for operations on natural numbers. 
-
-#pragma once
-#include <any>
-#include <algorithm>
-#include <cfloat>
-#include <cmath>
-#include <iostream>
-#include <iterator>
-#include <climits>
-#include <list>
-#include <memory>
-#include <string>
-#include <type_traits>
-#include <utility>
-#include <vector>
-
-using _ull = unsigned long long;
-using _ui = unsigned int;
-using _ld = long double;
-
-/**
- * @brief Number of binary digits in the base.
- * 
- */
-constexpr _ui BASE_BIN_LENGTH = static_cast<_ui>(std::numeric_limits<_ull>::digits / 2);
-
-/**
- * @brief Base to use to store digits.
- * <p> Note: Must be power of 2 <br>
- *     Note: Should be half the binary length of \p ULLONG_MAX <br>
- *     Note: Digits range from [0, base) 
- * </p>
- * 
- */
-constexpr _ull BASE = (ULLONG_MAX >> BASE_BIN_LENGTH) + 1;
-
-/**
- * @brief number of base10 digits in base
- * 
- */
-constexpr _ui BASE_DIGITS = static_cast<_ui>((std::numeric_limits<_ull>::digits10 / 2) + 1);
-
-/**
- * @brief Maximum number of base10 digits allowed to be stored.
- * <p> Store one less than allowed digits to allow initialization
- *     without an if statement to see if number fits into digit. <br>
- *     Ex: 9999999999 doesnt fit into base 2^32 but 999999999 does 
- * </p>
- * 
- */
-constexpr _ui BASE_DIGITS_ALLOW = BASE_DIGITS - 1;
-
-/**
- * @brief Statically usable log2 function.
- * 
- */
-_ui log_const(double num) {
-    _ui res = 0;
-    while (num > 0) {
-        num /= 2.0;
-        num = std::floor(num);
-        ++res;
-    }
-    return res;
-}
-
-/**
- * @brief If the number of digits in the container is less than or qual to this then a conversion without loss of precision can be used to double.
- * 
- */
-static const _ui DOUBLE_CONVERSION = (log_const(DBL_MAX) / log_const(static_cast<double>(BASE))) - 1;
-
-/**
- * @brief ty must be integral and unsigned type.
- * 
- * @tparam ty check type
- */
-template<typename ty, typename = std::enable_if_t<std::is_integral_v<ty> && std::is_unsigned_v<ty>>>
-struct _integral_unsigned {};
-
-/**
- * @brief Large unsigned interger class. Useful for [0,1000] base10 digits.
- * 
- */
-class BigUnsigned {
-    // call resize_to_fit to ensure leading zeros are gone is using sz_ty_ull constructor
-    // since all operations assume there are NO leading zeros
-public:
-
-    /**
-     * @brief Must have bi-directional iterator at least.
-     * 
-     */
-    using cont_ull = std::vector<_ull>;
-
-    /**
-     * @brief Must have random access iterator.
-     * 
-     */
-    using cont_ui = std::vector<_ui>; 
-    using sz_ty_ull = typename cont_ull::size_type; 
-    using sz_ty_ui = typename cont_ui::size_type; 
-
-private:
-
-    /**
-     * @brief Requires end - start <= \p MAX_DIGITS_NUM
-     * 
-     * @tparam Forward minimum forward iterator
-     * @return _ull distance for conversion calculation
-     */
-    template<typename Forward>
-    _ull _unchecked_to_num(Forward start, Forward end) {
-
-        _ld res = 0;
-        for (; start != end; ++start) {
-            res += static_cast<_ld>(*start) * std::pow(static_cast<_ld>(10), static_cast<_ld>(end - start - 1));
-        }
-
-        return static_cast<_ull>(std::llroundl(res));
-
-    }
-
-    template<typename Forward>
-    inline sz_ty_ui _local_size(Forward start, Forward end) {
-
-        return static_cast<sz_ty_ui>(std::distance(start, end));
-
-    }
-
-    /**
-     * @brief Convert from base10 to desired base and populate \p digits
-     * 
-     * @param digit_local_iter container to populate from
-     * @param size_local size of container
-     */
-    void _create(cont_ui::iterator digit_local_iter, sz_ty_ui size_local) {
-
-        std::list<_ull> digits_local; // to not have to preallocate required size
-
-        while (size_local >= BASE_DIGITS) {
-            _ull starting_num = _unchecked_to_num(digit_local_iter, digit_local_iter + BASE_DIGITS - 1);
-            auto end_cont = digit_local_iter + size_local;
-            auto start_cont = digit_local_iter + BASE_DIGITS - 1;
-            for (auto j = start_cont; j != end_cont; ++j, ++digit_local_iter) {
-                starting_num = (starting_num * 10) + *j;
-                *digit_local_iter = starting_num / BASE;
-                starting_num -= (starting_num / BASE) * BASE;
-            }
-            size_local = end_cont - start_cont;
-            digit_local_iter -= size_local;
-            digits_local.emplace_front(starting_num);
-        }
-
-        _ull num = _unchecked_to_num(digit_local_iter, digit_local_iter + size_local);
-        if (num != 0) {
-            digits_local.emplace_front(num);
-        }
-
-        std::copy(digits_local.cbegin(), digits_local.cend(), std::back_inserter(digits));
-
-        resize_to_fit();
-
-    }
-
-public:
-
-    explicit BigUnsigned() : digits() {}
-
-    /**
-     * @brief Construct a new Big Unsigned object from fundamental type array
-     * 
-     */
-    template<typename Integral, unsigned int N, typename = _integral_unsigned<Integral>>
-    explicit BigUnsigned(Integral(&arr)[N]) {
-
-        cont_ui digit_local(N);
-        std::copy(arr, arr + N, digit_local.begin());
-
-        _create(digit_local.begin(), N);
-
-    }
-
-   /**
-    * @brief Construct a new Big Unsigned object from forward iterator container.
-    * <p> Do not rigorously check that Forward is valid forward iterator.
-    *     Since not need all the forward iterator requirements are needed, 
-    *     just typedef value_type and that its multipass. Leave responsibility to user.
-    * </p>
-    * 
-    */
-    template<typename Forward, typename = _integral_unsigned<typename Forward::value_type>>
-    explicit BigUnsigned(Forward start, Forward end) {
-
-        auto size_local = _local_size(start, end);
-        cont_ui digit_local(size_local);
-        std::copy(start, end, digit_local.begin());
-
-        _create(digit_local.begin(), size_local);
-
-    }
-    
-private:
-
-    /**
-     * @brief Construct from string pointer. 
-     * 
-     */
-    void _str_init(const std::string* const s) {
-
-        auto size_local = _local_size(s->cbegin(), s->cend());
-        cont_ui digit_local(size_local);
-        auto digit_local_iter = digit_local.begin();
-        std::for_each(s->cbegin(), s->cend(), [&digit_local_iter](auto in) {
-            *digit_local_iter++ = in - '0';
-        });
-
-        _create(digit_local.begin(), size_local);
-
-    }
-
-public:
-
-    /**
-     * @brief Construct a new Big Unsigned object from string reference.
-     * 
-     */
-    explicit BigUnsigned(const std::string& s) {
-
-        _str_init(std::addressof(s));
-
-    }
-
-    /**
-     * @brief Construct a new Big Unsigned object from string pointer.
-     * 
-     */
-    explicit BigUnsigned(const std::string* const s) {
-
-        _str_init(s);
-
-    }
-
-    /**
-     * @brief Construct a new empty Big Unsigned object from size type.
-     * 
-     */
-    explicit BigUnsigned(sz_ty_ull size) : digits(size, 0) {} // initialize to 0's to allow remove of extra ones
-
-    /**
-     * @brief Remove the leading 0's.
-     * 
-     */
-    void resize_to_fit() {
-
-        auto iter = std::find_if_not(digits.cbegin(), digits.cend(), [](auto i) {
-            return i == 0;
-        });
-
-        if (iter != digits.cbegin()) {
-            cont_ull temp(iter, digits.cend());
-            digits = std::move(temp);
-        }
-
-    }
-
-    /**
-     * @brief Container containing digits of number.
-     * 
-     */
-    cont_ull digits;
-
-};
-
-/**
- * @brief Output raw digits.
- */
-std::ostream& operator<< (std::ostream& out, const BigUnsigned& num) {
-
-    std::copy(num.digits.cbegin(), num.digits.cend(), std::ostream_iterator<_ull>(out, ", "));
-    return out;
-
-}
-
-inline auto _longer(const BigUnsigned* const l, const BigUnsigned* const r) {
-
-    return std::max(l, r, [](auto l, auto r) {
-        return l->digits.size() < r->digits.size();
-    });
-
-}
-
-inline auto _shorter(const BigUnsigned* const l, const BigUnsigned* const r) {
-
-    return std::min(l, r, [](auto l, auto r) {
-        return l->digits.size() <= r->digits.size();
-    });
-
-}
-
-inline auto _longer_digits(const BigUnsigned* const l, const BigUnsigned* const r) {
-
-    return std::max(l, r, [](auto l, auto r) {
-        return l->digits.size() < r->digits.size();
-    })->digits;
-
-}
-
-inline auto _shorter_digits(const BigUnsigned* const l, const BigUnsigned* const r) {
-
-    return std::min(l, r, [](auto l, auto r) {
-        return l->digits.size() <= r->digits.size();
-    })->digits;
-
-}
-
-bool operator< (const BigUnsigned& l, const BigUnsigned& r) {
-
-    _ui l_len = l.digits.size();
-    _ui r_len = r.digits.size();
-    if (l_len < r_len) {
-         return true;
-    } else if (l_len > r_len) {
-        return false;
-    } 
-
-    auto l_iter = l.digits.cbegin();
-    auto r_iter = r.digits.cbegin();
-    while (l_iter != l.digits.cend() && *l_iter == *r_iter) {
-        ++l_iter;
-        ++r_iter;
-    }
-
-    return *l_iter < *r_iter;
-
-}
-
-bool operator> (const BigUnsigned& l, const BigUnsigned& r) {
-
-    return r < l;
-
-}
-
-bool operator<= (const BigUnsigned& l, const BigUnsigned& r) {
-
-    _ui l_len = l.digits.size();
-    _ui r_len = r.digits.size();
-    if (l_len > r_len) {
-        return false;
-    } else if (l_len < r_len) {
-        return true;
-    }
-
-    auto l_iter = l.digits.cbegin();
-    auto r_iter = r.digits.cbegin();
-    while (*l_iter == *r_iter && l_iter != l.digits.cend()) {
-        ++l_iter;
-        ++r_iter;
-    }
-
-    return (*l_iter <= *r_iter) || (l_iter == l.digits.cend());
-
-}
-
-bool operator>= (const BigUnsigned& l, const BigUnsigned& r) {
-
-    _ui l_len = l.digits.size();
-    _ui r_len = r.digits.size();
-    if (l_len > r_len) {
-        return true;
-    } else if (l_len < r_len) {
-        return false;
-    }
-
-    auto l_iter = l.digits.cbegin();
-    auto r_iter = r.digits.cbegin();
-    while (*l_iter == *r_iter && l_iter != l.digits.cend()) {
-        ++l_iter;
-        ++r_iter;
-    }
-
-    return (*l_iter >= *r_iter) || (l_iter == l.digits.cend());
-
-}
-
-/**
- * @brief <b> Fast </b> - theta(max(l.digits.size, r.digits.size))
- */
-BigUnsigned operator+ (const BigUnsigned& l, const BigUnsigned& r) {
-
-    auto longer = ::_longer(&l, &r);
-    auto shorter = ::_shorter(&l, &r);
-
-    BigUnsigned result(longer->digits.size() + 1);
-    auto new_digits = result.digits.rbegin();
-
-    auto l_iter = longer->digits.crbegin();
-    _ull carry = 0;
-    for (auto s_iter = shorter->digits.crbegin(); s_iter != shorter->digits.crend(); ++l_iter, ++s_iter, ++new_digits) {
-        _ull result = *l_iter + *s_iter + carry;
-        carry = result >> BASE_BIN_LENGTH;
-        *new_digits = result - (BASE * carry);
-    }
-
-    for (; l_iter != longer->digits.crend(); ++l_iter, ++new_digits) {
-        _ull result = *l_iter + carry;
-        carry = result >> BASE_BIN_LENGTH;
-        *new_digits = result - (BASE * carry);
-    }
-    
-    if (carry != 0) {
-        // result.digits.emplace(result.digits.cbegin(), carry);
-        result.digits.emplace(std::find_if_not(result.digits.cbegin(), result.digits.cend(), [](auto val) {
-            return val == 0;
-        }), carry);
-    }
-
-    result.resize_to_fit();
-
-    return result;
-
-}
-
-/**
- * @brief <b> Fast </b> - theta(max(l.digits.size, r.digits.size))
- * 
- * <p> Order is irrelevant, will always be larger - smaller. </p>
- * 
- */
-BigUnsigned operator- (const BigUnsigned& l, const BigUnsigned& r) {
-
-    auto longer = ::_longer(&l, &r);
-    auto shorter = ::_shorter(&l, &r);
-
-    BigUnsigned result(longer->digits.size());
-    auto new_digits = result.digits.rbegin();
-
-    if (l.digits.size() == r.digits.size()) { // same size
-        auto l_iter = l.digits.crbegin();
-        auto r_iter = r.digits.crbegin();
-
-        if (l > r) {
-            _ull carry = 0;
-            for (; l_iter != l.digits.crend(); ++l_iter, ++r_iter, ++new_digits) { // issue is crend includes the 0's need to get rid of the 0's somehow
-                _ull result = (*l_iter - carry) - *r_iter;
-                carry = (result >> BASE_BIN_LENGTH) & 1;
-                *new_digits = (result << BASE_BIN_LENGTH) >> BASE_BIN_LENGTH;
-            }
-        } else if (r > l) {
-            _ull carry = 0;
-            for (; l_iter != l.digits.crend(); ++l_iter, ++r_iter, ++new_digits) {
-                _ull result = (*r_iter - carry) - *l_iter;
-                carry = (result >> BASE_BIN_LENGTH) & 1;
-                *new_digits = (result << BASE_BIN_LENGTH) >> BASE_BIN_LENGTH;
-            }
-        } else {
-            return BigUnsigned("0");
-        }
-    } else {
-        auto l_iter = longer->digits.crbegin();
-        _ull carry = 0;
-        for (auto s_iter = shorter->digits.crbegin(); s_iter != shorter->digits.crend(); ++l_iter, ++s_iter, ++new_digits) {
-            _ull result = (*l_iter - carry) - *s_iter;
-            carry = (result >> BASE_BIN_LENGTH) & 1; // if carry is needed, then & 1 will always produce 1
-            *new_digits = (result << BASE_BIN_LENGTH) >> BASE_BIN_LENGTH;
-        }
-
-        for (; l_iter != longer->digits.crend(); ++l_iter, ++new_digits) {
-            _ull result = *l_iter - carry;
-            carry = (result >> BASE_BIN_LENGTH) & 1;
-            *new_digits = (result << BASE_BIN_LENGTH) >> BASE_BIN_LENGTH;
-        }
-    }
-
-    result.resize_to_fit();
-
-    return result;
-
-}
-
-/**
- * @brief <b> Slow </b> - theta(2 * l.digits.size * r.digits.size)
- */
-BigUnsigned operator* (const BigUnsigned& l, const BigUnsigned& r) {
-
-    BigUnsigned res("0");
-
-    for (auto r_iter = r.digits.crbegin(); r_iter != r.digits.crend(); ++r_iter) {
-        _ui shift = std::distance(r.digits.crbegin(), r_iter);
-
-        BigUnsigned curr(l.digits.size() + 1 + shift);
-        auto curr_iter = curr.digits.rbegin();
-        for (_ui i = 0; i != shift; ++i, ++curr_iter) {
-            *curr_iter = 0;
-        }
-        _ull carry = 0;
-        for (auto l_iter = l.digits.crbegin(); l_iter != l.digits.crend(); ++l_iter, ++curr_iter) {
-            _ull result = *l_iter * *r_iter + carry;
-            carry = result >> BASE_BIN_LENGTH;
-            *curr_iter = result - (BASE * carry);
-        }
-        *curr_iter = carry;
-
-        res = res + curr;
-    }
-
-    return res;
-
-}
-
-/**
- * @brief Meant for positive only.
- */
-BigUnsigned divide_digit(typename BigUnsigned::cont_ull::const_iterator start, typename BigUnsigned::cont_ull::const_iterator end, const _ull digit) {
-
-    BigUnsigned res(std::distance(start, end));
-    auto iter_res = res.digits.begin();
-
-    _ull carry = 0;
-
-    for (; start != end; ++start, ++iter_res) {
-        *iter_res = (*start + (carry * BASE)) / digit;
-        carry = *start - (digit * *iter_res); 
-    }
-
-    res.resize_to_fit();
-
-    return res;
-
-}
-
-BigUnsigned divide(const BigUnsigned* const remainder, const BigUnsigned* const denom, const _ull digit) {
-
-    return divide_digit(remainder->digits.cbegin(), remainder->digits.cbegin() + (remainder->digits.size() - denom->digits.size() + 1), digit);
-
-}
-
-/**
- * @brief Meant for negative only. 
- * 
- *  
- */
-BigUnsigned divide_digit_neg(typename BigUnsigned::cont_ull::const_iterator start, typename BigUnsigned::cont_ull::const_iterator end, const _ull digit) {
-
-    BigUnsigned res(std::distance(start, end));
-    auto iter_res = res.digits.begin();
-
-    _ull carry = 0;
-
-    for (; start != end - 1; ++start, ++iter_res) {
-        *iter_res = (*start + (carry * BASE)) / digit;
-        carry = *start - (digit * *iter_res); 
-    }
-    
-    *iter_res = (*start + digit + (carry * BASE)) / digit; // add digit since when negative integers rounded down is the same as rounding up when positive
-
-    res.resize_to_fit();
-
-    return res;
-
-}
-
-BigUnsigned divide_neg(const BigUnsigned* const remainder, const BigUnsigned* const denom, const _ull digit) {
-
-    return divide_digit_neg(remainder->digits.cbegin(), remainder->digits.cbegin() + (remainder->digits.size() - denom->digits.size() + 1), digit);
-
-}
-
-/**
- * @brief <b> Very Slow </b> - theta(c * n.digits.size * operator*)
- * 
- * <p> Note: To use n >= d </p>
- * 
- */
-BigUnsigned operator/ (const BigUnsigned& n, const BigUnsigned& d) {
-
-    _ui m = d.digits.size() - 1;
-    _ull a = *d.digits.cbegin();
-    BigUnsigned q = divide(&n, &d, a);
-    q.resize_to_fit();
-    BigUnsigned r = d;
-
-    if (n > q * d) { // division is complete
-        return q;
-    }
-
-    while (r >= d && r.digits.size() > 0) {
-        r = n - (q * d);     
-        if (r.digits.size() >= d.digits.size()) {
-            auto qn = q - divide_neg(&r, &d, a); 
-            auto sum = q + qn;
-            q = divide_digit(sum.digits.cbegin(), sum.digits.cend(), 2);
-        }
-    }
-
-    return q;
-
-}
-
-/**
- * @brief <b> Quick </b> - theta(log2(pow.digits.size) * operator/ * operator*)
- */
-BigUnsigned pow(const BigUnsigned& base, const BigUnsigned& pow) {
-
-    BigUnsigned res("1");
-    auto base_copy = base;
-    auto pow_copy = pow;
-
-    while (pow_copy.digits.size() != 0) {
-        if (*pow_copy.digits.crbegin() % 2 == 1) {
-            res = base_copy * res;
-        }
-        pow_copy = pow_copy / BigUnsigned("2");
-        base_copy = base_copy * base_copy;
-    }
-
-    return res;
-
-}
-
-template<typename T>
-T _add_10(T* l, T* r) {
-
-    auto longer = std::max(l, r, [](auto l, auto r) {
-        return l->size() < r->size();
-    });
-    
-    auto shorter = std::min(l, r, [](auto l, auto r) {
-        return l->size() <= r->size();
-    });
-
-    T ret(longer->size());
-    auto ret_iter = ret.rbegin();
-    auto l_iter = longer->crbegin();
-    typename T::value_type carry = 0;
-    for (auto s_iter = shorter->crbegin(); s_iter != shorter->crend(); ++l_iter, ++s_iter, ++ret_iter) {
-        *ret_iter = (carry + *l_iter + *s_iter) % 10;
-        carry = (carry + *l_iter + *s_iter) >= 10 ? 1 : 0; 
-
-    }
-
-    for (; l_iter != longer->crend(); ++l_iter, ++ret_iter) {
-
-        *ret_iter = (carry + *l_iter) % 10;
-        carry = (carry + *l_iter) >= 10 ? 1 : 0; 
-
-    }
-
-    if (carry != 0) {
-        ret.insert(ret.cbegin(), carry);
-    }
-
-    return ret;
-
-}
-
-template<typename T>
-T _mult_10(T* l, T* r) {
-
-    T ret(1, 0);
-    for (auto iter_r = r->rbegin(); iter_r != r->rend(); ++iter_r) {
-        _ui shift = std::distance(r->rbegin(), iter_r);
-
-        T curr(l->size() + 1 + shift);
-        auto curr_iter = curr.rbegin();
-        for (_ui i = 0; i != shift; ++i, ++curr_iter) {
-            *curr_iter = 0;
-        }
-
-        typename T::value_type carry = 0;
-        for (auto iter_l = l->crbegin(); iter_l != l->crend(); ++iter_l, ++curr_iter) {
-            *curr_iter = (*iter_l * *iter_r + carry) % 10;
-            carry = ((*iter_l * *iter_r + carry) - *curr_iter) / 10;
-        }
-        *curr_iter = carry;
-
-        ret = _add_10(&ret, &curr);
-    }
-
-    return ret;
-
-}
-
-/**
- * @brief Convert \p BigUnsigned to a container of base10 digits.
- * 
- */
-BigUnsigned::cont_ull BigUnsigned_10(const BigUnsigned& num) {
-
-    BigUnsigned::cont_ull base_vec(BASE_DIGITS);
-    BigUnsigned::cont_ull res(1, 0);
-
-    auto base = BASE;
-    for (auto iter = base_vec.rbegin(); iter != base_vec.rend(); ++iter) {
-        *iter = base % 10;
-        base /= 10;
-    }
-    BigUnsigned::cont_ull power_curr_vec{1};
-
-    using value_ty = BigUnsigned::cont_ull::value_type;
-
-    for (auto iter = num.digits.crbegin(); iter != num.digits.crend(); ++iter) {
-
-        BigUnsigned::cont_ull digit_cont;
-        BigUnsigned::cont_ull::value_type digit = *iter;
-        while (digit > 0) {
-            digit_cont.insert(digit_cont.begin(), digit % 10);
-            digit /= 10;
-        }
-
-        auto temp = _mult_10(&digit_cont, &power_curr_vec);
-        res = _add_10(&res, &temp);
-
-        power_curr_vec = _mult_10(&power_curr_vec, &base_vec);
-
-    }
-
-    auto iter = std::find_if_not(res.cbegin(), res.cend(), [](auto i) {
-            return i == 0;
-    });
-
-    if (iter != res.cbegin()) {
-        return BigUnsigned::cont_ull(iter, res.cend());
-    }
-
-    return res;
-
-}
-
-/**
- * @brief If possible return \p BigUnsigned as double value. 
- * 
- * <p> Use \p BigUnsigned_10 function for guarnteed accuracy. </p>
- * 
- * @return -1 if exceeds double without loss precision
- */
-double BigUnsigned_10_dbl(const BigUnsigned& num) {
-
-    if (num.digits.size() > DOUBLE_CONVERSION) {
-        return -1;
-    }
-
-    double res = 0.0;
-    double i = 0;
-    for (auto iter = num.digits.rbegin(); iter != num.digits.rend(); ++iter) {
-        res += pow(static_cast<double>(BASE), i) * static_cast<double>(*iter);
-        ++i;
-    }
-
-    return res;
-
-}
\ No newline at end of file
+// Author: Dennis Yakovlev
+
+// File containing all members relating to BigUnsigned type.
+// Allows for operations on natural numbers. 
+
+#pragma once
+#include <any>
+#include <algorithm>
+#include <BigInt_alloc.h>
+#include <BigInt_limbs.h>
+#include <BigInt_vars.h>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <climits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<typename Random>
+void _from_base10(Random s, std::size_t n, _limb zero, _limb_vec* res);
+
+/**
+ * @brief Large unsigned interger class. Useful for [0,1000] base10 digits.
+ * 
+ */
+class BigUnsigned {
+    // call resize_to_fit to ensure leading zeros are gone is using sz_ty_ull constructor
+    // since all operations assume there are NO leading zeros
+    // digits are stored least significant first, so leading zeros are at the back
+public:
+
+    /**
+     * @brief Must have bi-directional iterator at least.
+     * 
+     */
+    using cont_ull = _limb_storage;
+
+    /**
+     * @brief Must have random access iterator.
+     * 
+     */
+    using cont_ui = std::vector<_ui>; 
+    using sz_ty_ull = typename cont_ull::size_type; 
+    using sz_ty_ui = typename cont_ui::size_type; 
+
+    explicit BigUnsigned() : digits() {}
+
+    /**
+     * @brief <b> Fast </b> - theta(sizeof(Integral) / sizeof(_limb)). Construct a new Big Unsigned
+     *        object with the value of a native unsigned integer.
+     * 
+     */
+    template<typename Integral, typename = _integral_unsigned<Integral>>
+    explicit BigUnsigned(Integral num, NATIVE) {
+
+        if constexpr (sizeof(Integral) <= sizeof(_limb)) {
+            if (num != 0) {
+                digits.emplace_back(static_cast<_limb>(num));
+            }
+        } else {
+            for (; num != 0; num >>= BASE_BIN_LENGTH) {
+                digits.emplace_back(static_cast<_limb>(num));
+            }
+        }
+
+    }
+
+    /**
+     * @brief Construct a new Big Unsigned object from fundamental type array of base10 digits.
+     * 
+     */
+    template<typename Integral, unsigned int N, typename = _integral_unsigned<Integral>>
+    explicit BigUnsigned(Integral(&arr)[N]) {
+
+        _from_base10(arr, N, 0, &digits);
+
+    }
+
+   /**
+    * @brief Construct a new Big Unsigned object from forward iterator container of base10 digits.
+    * <p> Do not rigorously check that Forward is valid forward iterator.
+    *     Since not need all the forward iterator requirements are needed, 
+    *     just typedef value_type and that its multipass. Leave responsibility to user.
+    * </p>
+    * 
+    */
+    template<typename Forward, typename = _integral_unsigned<typename Forward::value_type>>
+    explicit BigUnsigned(Forward start, Forward end) {
+
+        cont_ui digit_local(start, end);
+
+        _from_base10(digit_local.cbegin(), digit_local.size(), 0, &digits);
+
+    }
+
+    /**
+     * @brief Construct a new Big Unsigned object from base10 string reference.
+     * 
+     */
+    explicit BigUnsigned(const std::string& s) {
+
+        _from_base10(s.cbegin(), s.size(), '0', &digits);
+
+    }
+
+    /**
+     * @brief Construct a new Big Unsigned object from base10 string pointer.
+     * 
+     */
+    explicit BigUnsigned(const std::string* const s) {
+
+        _from_base10(s->cbegin(), s->size(), '0', &digits);
+
+    }
+
+    /**
+     * @brief Construct a new empty Big Unsigned object from size type.
+     * 
+     */
+    explicit BigUnsigned(sz_ty_ull size) : digits(size, 0) {} // initialize to 0's to allow remove of extra ones
+
+    /**
+     * @brief Construct a new Big Unsigned object equal to 0 whose digits come from \p res
+     *        instead of the thread's current resource.
+     * 
+     */
+    explicit BigUnsigned(std::pmr::memory_resource* res) : digits(res) {}
+
+    /**
+     * @brief Remove the leading 0's.
+     * 
+     */
+    void resize_to_fit() {
+
+        digits.resize(_limbs_norm(digits.data(), digits.size()));
+
+    }
+
+    /**
+     * @brief Container containing digits of number. Least significant first.
+     * 
+     */
+    cont_ull digits;
+
+};
+
+/**
+ * @brief Output raw digits, most significant first.
+ */
+std::ostream& operator<< (std::ostream& out, const BigUnsigned& num) {
+
+    std::copy(num.digits.crbegin(), num.digits.crend(), std::ostream_iterator<BigUnsigned::cont_ull::value_type>(out, ", "));
+    return out;
+
+}
+
+inline auto _longer(const BigUnsigned* const l, const BigUnsigned* const r) {
+
+    return std::max(l, r, [](auto l, auto r) {
+        return l->digits.size() < r->digits.size();
+    });
+
+}
+
+inline auto _shorter(const BigUnsigned* const l, const BigUnsigned* const r) {
+
+    return std::min(l, r, [](auto l, auto r) {
+        return l->digits.size() <= r->digits.size();
+    });
+
+}
+
+inline auto _longer_digits(const BigUnsigned* const l, const BigUnsigned* const r) {
+
+    return std::max(l, r, [](auto l, auto r) {
+        return l->digits.size() < r->digits.size();
+    })->digits;
+
+}
+
+inline auto _shorter_digits(const BigUnsigned* const l, const BigUnsigned* const r) {
+
+    return std::min(l, r, [](auto l, auto r) {
+        return l->digits.size() <= r->digits.size();
+    })->digits;
+
+}
+
+bool operator< (const BigUnsigned& l, const BigUnsigned& r) {
+
+    return _limbs_cmp(l.digits.data(), l.digits.size(), r.digits.data(), r.digits.size()) < 0;
+
+}
+
+bool operator> (const BigUnsigned& l, const BigUnsigned& r) {
+
+    return r < l;
+
+}
+
+bool operator<= (const BigUnsigned& l, const BigUnsigned& r) {
+
+    return !(r < l);
+
+}
+
+bool operator>= (const BigUnsigned& l, const BigUnsigned& r) {
+
+    return !(l < r);
+
+}
+
+bool operator== (const BigUnsigned& l, const BigUnsigned& r) {
+
+    return l.digits == r.digits;
+
+}
+
+bool operator!= (const BigUnsigned& l, const BigUnsigned& r) {
+
+    return !(l == r);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(max(l.digits.size, r.digits.size))
+ * 
+ * <p> Reuses the storage of \p l, only allocates when \p l has to grow past its capacity. </p>
+ * 
+ */
+BigUnsigned& operator+= (BigUnsigned& l, const BigUnsigned& r) {
+
+    if (l.digits.size() < r.digits.size()) {
+        l.digits.resize(r.digits.size(), 0);
+    }
+
+    _limb carry = _limbs_add(l.digits.data(), l.digits.data(), l.digits.size(), r.digits.data(), r.digits.size());
+    if (carry != 0) {
+        l.digits.emplace_back(carry);
+    }
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(max(l.digits.size, r.digits.size))
+ * 
+ * <p> Same as operator-, order is irrelevant, \p l becomes larger - smaller. </p>
+ * 
+ */
+BigUnsigned& operator-= (BigUnsigned& l, const BigUnsigned& r) {
+
+    if (l >= r) {
+        _limbs_sub(l.digits.data(), l.digits.data(), l.digits.size(), r.digits.data(), r.digits.size());
+    } else {
+        auto l_digits_size = l.digits.size();
+        l.digits.resize(r.digits.size(), 0);
+        _limbs_sub(l.digits.data(), r.digits.data(), r.digits.size(), l.digits.data(), l_digits_size);
+    }
+
+    l.resize_to_fit();
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(l.digits.size). Multiply by a single digit.
+ * 
+ */
+BigUnsigned& operator*= (BigUnsigned& l, _limb r) {
+
+    if (r == 0) {
+        l.digits.clear();
+        return l;
+    }
+
+    _limb carry = _limbs_mul_1(l.digits.data(), l.digits.data(), l.digits.size(), r);
+    if (carry != 0) {
+        l.digits.emplace_back(carry);
+    }
+
+    return l;
+
+}
+
+/**
+ * @brief res = l * r where \p res does not alias \p l or \p r. Reuses the storage of \p res.
+ * 
+ */
+void _mul_to(BigUnsigned* res, const BigUnsigned& l, const BigUnsigned& r) {
+
+    if (l.digits.empty() || r.digits.empty()) {
+        res->digits.clear();
+        return;
+    }
+
+    res->digits.resize(l.digits.size() + r.digits.size());
+    _limbs_mul(res->digits.data(), l.digits.data(), l.digits.size(), r.digits.data(), r.digits.size());
+    res->resize_to_fit();
+
+}
+
+/**
+ * @brief <b> Quick </b> - num * num. Squaring does about half the digit multiplies of a
+ *        general multiplication, see \p _limbs_sqr.
+ * 
+ * <p> \p operator* and \p operator*= square automatically when both operands are the
+ *     same object, this is for squaring an expression.
+ * </p>
+ * 
+ */
+BigUnsigned square(const BigUnsigned& num) {
+
+    BigUnsigned res;
+    _mul_to(&res, num, num);
+
+    return res;
+
+}
+
+/**
+ * @brief <b> Quick </b> - see operator*
+ * 
+ * <p> The product is made in a per thread scratch number whose storage is then swapped
+ *     with \p l, so repeated use does not allocate once the storage is large enough.
+ *     The scratch always uses the heap so it never holds storage of a reset arena,
+ *     products for numbers using another resource are copied instead.
+ * </p>
+ * 
+ */
+BigUnsigned& operator*= (BigUnsigned& l, const BigUnsigned& r) {
+
+    thread_local BigUnsigned scratch(bigint_heap_resource());
+
+    _mul_to(&scratch, l, r);
+    if (l.digits.resource() == scratch.digits.resource()) {
+        l.digits.swap(scratch.digits);
+    } else {
+        l.digits = scratch.digits;
+    }
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(max(l.digits.size, r.digits.size))
+ */
+BigUnsigned operator+ (const BigUnsigned& l, const BigUnsigned& r) {
+
+    BigUnsigned res = *::_longer(&l, &r);
+
+    return res += *::_shorter(&l, &r);
+
+}
+
+BigUnsigned operator+ (BigUnsigned&& l, const BigUnsigned& r) {
+
+    return std::move(l += r);
+
+}
+
+BigUnsigned operator+ (const BigUnsigned& l, BigUnsigned&& r) {
+
+    return std::move(r += l);
+
+}
+
+BigUnsigned operator+ (BigUnsigned&& l, BigUnsigned&& r) {
+
+    return std::move(l += r);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(max(l.digits.size, r.digits.size))
+ * 
+ * <p> Order is irrelevant, will always be larger - smaller. </p>
+ * 
+ */
+BigUnsigned operator- (const BigUnsigned& l, const BigUnsigned& r) {
+
+    BigUnsigned res = l >= r ? l : r;
+
+    return res -= l >= r ? r : l;
+
+}
+
+BigUnsigned operator- (BigUnsigned&& l, const BigUnsigned& r) {
+
+    return std::move(l -= r);
+
+}
+
+BigUnsigned operator- (const BigUnsigned& l, BigUnsigned&& r) {
+
+    return std::move(r -= l);
+
+}
+
+BigUnsigned operator- (BigUnsigned&& l, BigUnsigned&& r) {
+
+    return std::move(l -= r);
+
+}
+
+/**
+ * @brief <b> Quick </b> - theta(schoolbook, Karatsuba, Toom-3 or NTT depending on size)
+ * 
+ * <p> See \p _limbs_mul for how the algorithm is picked. </p>
+ * 
+ */
+BigUnsigned operator* (const BigUnsigned& l, const BigUnsigned& r) {
+
+    BigUnsigned res;
+    _mul_to(&res, l, r);
+
+    return res;
+
+}
+
+BigUnsigned operator* (BigUnsigned&& l, const BigUnsigned& r) {
+
+    return std::move(l *= r);
+
+}
+
+BigUnsigned operator* (const BigUnsigned& l, BigUnsigned&& r) {
+
+    return std::move(r *= l);
+
+}
+
+BigUnsigned operator* (BigUnsigned&& l, BigUnsigned&& r) {
+
+    return std::move(l *= r);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(l.digits.size + bits / BASE_BIN_LENGTH). Multiply by 2 ^ bits.
+ * 
+ */
+BigUnsigned& operator<<= (BigUnsigned& l, std::size_t bits) {
+
+    if (l.digits.empty()) {
+        return l;
+    }
+
+    const auto n = l.digits.size();
+    const auto limbs = bits / BASE_BIN_LENGTH;
+
+    l.digits.resize(n + limbs + 1, 0);
+    auto* d = l.digits.data();
+    d[n + limbs] = _limbs_lshift(d + limbs, d, n, static_cast<_ui>(bits % BASE_BIN_LENGTH));
+    std::fill(d, d + limbs, 0);
+    l.resize_to_fit();
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(l.digits.size + bits / BASE_BIN_LENGTH). Multiply by 2 ^ bits.
+ * 
+ */
+BigUnsigned operator<< (const BigUnsigned& l, std::size_t bits) {
+
+    if (l.digits.empty()) {
+        return BigUnsigned();
+    }
+
+    const auto n = l.digits.size();
+    const auto limbs = bits / BASE_BIN_LENGTH;
+
+    BigUnsigned res(static_cast<BigUnsigned::sz_ty_ull>(n + limbs + 1));
+    auto* d = res.digits.data();
+    d[n + limbs] = _limbs_lshift(d + limbs, l.digits.data(), n, static_cast<_ui>(bits % BASE_BIN_LENGTH));
+    res.resize_to_fit();
+
+    return res;
+
+}
+
+BigUnsigned operator<< (BigUnsigned&& l, std::size_t bits) {
+
+    return std::move(l <<= bits);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(l.digits.size). Divide by 2 ^ bits, rounding down.
+ * 
+ */
+BigUnsigned& operator>>= (BigUnsigned& l, std::size_t bits) {
+
+    const auto n = l.digits.size();
+    const auto limbs = bits / BASE_BIN_LENGTH;
+
+    if (limbs >= n) {
+        l.digits.clear();
+        return l;
+    }
+
+    auto* d = l.digits.data();
+    _limbs_rshift(d, d + limbs, n - limbs, static_cast<_ui>(bits % BASE_BIN_LENGTH));
+    l.digits.resize(n - limbs);
+    l.resize_to_fit();
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(l.digits.size). Divide by 2 ^ bits, rounding down.
+ * 
+ */
+BigUnsigned operator>> (const BigUnsigned& l, std::size_t bits) {
+
+    const auto n = l.digits.size();
+    const auto limbs = bits / BASE_BIN_LENGTH;
+
+    if (limbs >= n) {
+        return BigUnsigned();
+    }
+
+    BigUnsigned res(static_cast<BigUnsigned::sz_ty_ull>(n - limbs));
+    _limbs_rshift(res.digits.data(), l.digits.data() + limbs, n - limbs, static_cast<_ui>(bits % BASE_BIN_LENGTH));
+    res.resize_to_fit();
+
+    return res;
+
+}
+
+BigUnsigned operator>> (BigUnsigned&& l, std::size_t bits) {
+
+    return std::move(l >>= bits);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1). Number of binary digits of \p num, 0 for 0.
+ * 
+ */
+inline std::size_t bit_length(const BigUnsigned& num) {
+
+    if (num.digits.empty()) {
+        return 0;
+    }
+
+    return (num.digits.size() - 1) * BASE_BIN_LENGTH + _limb_bit_length(num.digits.back());
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1)
+ * 
+ */
+inline bool is_odd(const BigUnsigned& num) {
+
+    return !num.digits.empty() && (num.digits.front() & 1) != 0;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(n.digits.size). n = n / d, returns n % d.
+ * 
+ * <p> Powers of two are shifts, divisors that fit a digit use \p _limbs_divrem_1.
+ *     Only with 32 bit digits can d need two digits, that uses \p _limbs_divrem.
+ * </p>
+ * <p> Note: d must not be 0 </p>
+ * 
+ */
+std::uint64_t _divrem_native(BigUnsigned* n, std::uint64_t d) {
+
+    assert(d != 0 && "division by 0");
+
+    auto& digits = n->digits;
+    if (digits.empty()) {
+        return 0;
+    }
+
+    // shift in two halves, a shift by all of BASE_BIN_LENGTH is undefined with 64 bit digits
+    constexpr _ui half = BASE_BIN_LENGTH / 2;
+
+    if ((d & (d - 1)) == 0) {
+        std::uint64_t rem = 0;
+        std::size_t bits = 0;
+        for (; (d >> bits) != 1; ++bits) {}
+        for (std::size_t i = 0; i != digits.size() && i * BASE_BIN_LENGTH < bits; ++i) {
+            rem |= static_cast<std::uint64_t>(digits[i]) << (i * BASE_BIN_LENGTH);
+        }
+        *n >>= bits;
+        return rem & (d - 1);
+    }
+
+    if (d <= BASE_MASK) {
+        const _limb rem = _limbs_divrem_1(digits.data(), digits.data(), digits.size(), static_cast<_limb>(d));
+        n->resize_to_fit();
+        return rem;
+    }
+
+    const _limb v[2] = {static_cast<_limb>(d), static_cast<_limb>(d >> half >> half)};
+    if (_limbs_cmp(digits.data(), digits.size(), v, 2) < 0) {
+        std::uint64_t rem = digits[0];
+        if (digits.size() == 2) {
+            rem |= static_cast<std::uint64_t>(digits[1]) << half << half;
+        }
+        digits.clear();
+        return rem;
+    }
+
+    _limb_vec q(digits.size() - 1);
+    _limb r[2];
+    _limbs_divrem(q.data(), r, digits.data(), digits.size(), v, 2);
+    digits.assign(q.begin(), q.end());
+    n->resize_to_fit();
+
+    return r[0] | (static_cast<std::uint64_t>(r[1]) << half << half);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(l.digits.size). Divide by a native non zero integer.
+ * 
+ */
+BigUnsigned& operator/= (BigUnsigned& l, std::uint64_t r) {
+
+    _divrem_native(&l, r);
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(end - start). Divide the digits in [start, end) by a single non zero digit.
+ * 
+ * <p> Writes the quotient straight into the result, powers of two are shifts. </p>
+ * 
+ */
+BigUnsigned divide_digit(typename BigUnsigned::cont_ull::const_iterator start, typename BigUnsigned::cont_ull::const_iterator end, const _limb digit) {
+
+    assert(digit != 0 && "division by 0");
+
+    const auto n = static_cast<std::size_t>(end - start);
+    BigUnsigned res(static_cast<BigUnsigned::sz_ty_ull>(n));
+    if (n == 0) {
+        return res;
+    }
+
+    if ((digit & (digit - 1)) == 0) {
+        _limbs_rshift(res.digits.data(), &*start, n, _limb_ctz(digit));
+    } else {
+        _limbs_divrem_1(res.digits.data(), &*start, n, digit);
+    }
+    res.resize_to_fit();
+
+    return res;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(d.digits.size * (n.digits.size - d.digits.size + 1))
+ * 
+ * <p> Quotient and remainder of n / d. Single digit divisors use \p _limbs_divrem_1,
+ *     otherwise Knuth algorithm D through \p _limbs_divrem.
+ * </p>
+ * <p> Note: d must not be 0 </p>
+ * 
+ * @return std::pair<BigUnsigned, BigUnsigned> first) quotient <br> second) remainder
+ */
+std::pair<BigUnsigned, BigUnsigned> divmod(const BigUnsigned& n, const BigUnsigned& d) {
+
+    assert(!d.digits.empty() && "division by 0");
+
+    if (n < d) {
+        return std::pair(BigUnsigned(), n);
+    }
+
+    const auto nn = n.digits.size();
+    const auto dn = d.digits.size();
+    BigUnsigned q(nn - dn + 1);
+    BigUnsigned r(dn);
+
+    if (dn == 1) {
+        r.digits.front() = _limbs_divrem_1(q.digits.data(), n.digits.data(), nn, d.digits.front());
+    } else {
+        _limbs_divrem(q.digits.data(), r.digits.data(), n.digits.data(), nn, d.digits.data(), dn);
+    }
+
+    q.resize_to_fit();
+    r.resize_to_fit();
+
+    return std::pair(std::move(q), std::move(r));
+
+}
+
+/**
+ * @brief <b> Fast </b> - see \p divmod
+ * 
+ */
+BigUnsigned& operator/= (BigUnsigned& n, const BigUnsigned& d) {
+
+    if (d.digits.size() == 1) {
+        return n /= d.digits.front();
+    }
+
+    n = divmod(n, d).first;
+
+    return n;
+
+}
+
+/**
+ * @brief <b> Fast </b> - see \p divmod
+ * 
+ */
+BigUnsigned operator/ (const BigUnsigned& n, const BigUnsigned& d) {
+
+    return divmod(n, d).first;
+
+}
+
+BigUnsigned operator/ (BigUnsigned&& n, const BigUnsigned& d) {
+
+    return std::move(n /= d);
+
+}
+
+/**
+ * @brief <b> Fast </b> - see \p divmod
+ * 
+ */
+BigUnsigned operator% (const BigUnsigned& n, const BigUnsigned& d) {
+
+    return divmod(n, d).second;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(n.digits.size). Quotient and remainder of n / d for a native d.
+ * 
+ * <p> Note: d must not be 0 </p>
+ * 
+ */
+std::pair<BigUnsigned, std::uint64_t> divmod(const BigUnsigned& n, std::uint64_t d) {
+
+    BigUnsigned q(n);
+    const auto r = _divrem_native(&q, d);
+
+    return std::pair(std::move(q), r);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(n.digits.size)
+ * 
+ */
+BigUnsigned operator/ (const BigUnsigned& n, std::uint64_t d) {
+
+    return divmod(n, d).first;
+
+}
+
+BigUnsigned operator/ (BigUnsigned&& n, std::uint64_t d) {
+
+    return std::move(n /= d);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(n.digits.size)
+ * 
+ */
+std::uint64_t operator% (const BigUnsigned& n, std::uint64_t d) {
+
+    return divmod(n, d).second;
+
+}
+
+/**
+ * @brief <b> Quick </b> - theta(log2(pow) * operator*)
+ * 
+ * <p> Left to right binary exponentiation, reads the bits of \p pow directly.
+ *     Squares the result in place (res *= res takes the squaring path) and multiplies
+ *     it by the unchanged base, so the multiplications by the base stay unbalanced and cheap.
+ * </p>
+ * 
+ */
+BigUnsigned pow(const BigUnsigned& base, const BigUnsigned& pow) {
+
+    BigUnsigned res(1u, NATIVE{});
+    const bool single = base.digits.size() == 1;
+
+    for (std::size_t bit = bit_length(pow); bit-- != 0;) {
+        res *= res;
+        if ((pow.digits[bit / BASE_BIN_LENGTH] >> (bit % BASE_BIN_LENGTH)) & 1) {
+            if (single) {
+                res *= base.digits.front(); // in place, no scratch product
+            } else {
+                res *= base;
+            }
+        }
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief Cached power of 10 used to split numbers during base10 conversion.
+ * 
+ */
+struct _pow10_entry {
+    _limb_vec pow; // 10 ^ (DEC_CHUNK_DIGITS * 2^k), least significant first
+    _limb_vec mu; // BASE ^ (2 * pow.size) / pow, reciprocal for Barrett reduction, empty until needed
+    std::size_t digits; // DEC_CHUNK_DIGITS * 2^k, number of base10 digits of a remainder
+};
+
+/**
+ * @brief Get 10 ^ (DEC_CHUNK_DIGITS * 2^k), computing and caching it if needed.
+ * 
+ * <p> Entries are never removed so references stay valid until more entries are added. <br>
+ *     The reciprocal is only computed when \p reciprocal, converting from base10 does not need it.
+ * </p>
+ * 
+ */
+const _pow10_entry& _pow10_cached(std::size_t k, bool reciprocal = true) {
+
+    static std::vector<_pow10_entry> cache;
+
+    // cache outlives any request arena
+    resource_scope heap(bigint_heap_resource());
+
+    while (cache.size() <= k) {
+        _pow10_entry entry;
+        if (cache.empty()) {
+            entry.pow = _limb_vec(1, DEC_CHUNK);
+            entry.digits = DEC_CHUNK_DIGITS;
+        } else {
+            const auto& prev = cache.back().pow;
+            entry.pow.resize(2 * prev.size());
+            _limbs_mul(entry.pow.data(), prev.data(), prev.size(), prev.data(), prev.size());
+            entry.pow.resize(_limbs_norm(entry.pow.data(), entry.pow.size()));
+            entry.digits = 2 * cache.back().digits;
+        }
+
+        cache.emplace_back(std::move(entry));
+    }
+
+    auto& entry = cache[k];
+    if (reciprocal && entry.mu.empty()) {
+        const auto n = entry.pow.size();
+        _limb_vec numer(2 * n + 1, 0);
+        numer.back() = 1;
+        entry.mu.resize(n + 2);
+        if (n == 1) {
+            _limbs_divrem_1(entry.mu.data(), numer.data(), numer.size(), entry.pow.front());
+        } else {
+            _limb_vec rem(n);
+            _limbs_divrem(entry.mu.data(), rem.data(), numer.data(), numer.size(), entry.pow.data(), n);
+        }
+        entry.mu.resize(_limbs_norm(entry.mu.data(), entry.mu.size()));
+    }
+
+    return entry;
+
+}
+
+/**
+ * @brief <b> Slow </b> - theta(n^2). Convert base10 digits \p s[0, n) to normalized digits,
+ *        \p DEC_CHUNK_DIGITS base10 digits at a time.
+ * 
+ * @param zero value of the base10 digit 0 in \p s
+ */
+template<typename Random>
+void _from_base10_chunks(Random s, std::size_t n, _limb zero, _limb_vec* res) {
+
+    res->clear();
+    res->reserve(n / DEC_CHUNK_DIGITS + 1);
+
+    std::size_t len = n % DEC_CHUNK_DIGITS; // first chunk takes what does not fit evenly
+    if (len == 0) {
+        len = DEC_CHUNK_DIGITS;
+    }
+
+    for (std::size_t pos = 0; pos < n; pos += len, len = DEC_CHUNK_DIGITS) {
+        _limb chunk = 0;
+        for (auto iter = s + pos; iter != s + pos + len; ++iter) {
+            chunk = chunk * 10 + (static_cast<_limb>(*iter) - zero);
+        }
+
+        // res = res * DEC_CHUNK + chunk
+        _limb top = _limbs_mul_1(res->data(), res->data(), res->size(), DEC_CHUNK);
+        for (auto& digit : *res) {
+            digit += chunk;
+            chunk = digit < chunk;
+            if (chunk == 0) {
+                break;
+            }
+        }
+        top += chunk;
+        if (top != 0) {
+            res->emplace_back(top);
+        }
+    }
+
+}
+
+/**
+ * @brief <b> Quick </b> - theta(log(n) * operator*). Convert base10 digits \p s[0, n) to
+ *        normalized digits.
+ * 
+ * <p> Splits the digits by a cached power of 10 (divide and conquer), so the halves
+ *     are combined with one multiplication. Pieces of at most \p DEC_CONVERSION_THRESHOLD
+ *     chunks are converted by \p _from_base10_chunks.
+ * </p>
+ * 
+ * @param zero value of the base10 digit 0 in \p s
+ */
+template<typename Random>
+void _from_base10(Random s, std::size_t n, _limb zero, _limb_vec* res) {
+
+    if (n <= DEC_CHUNK_DIGITS * DEC_CONVERSION_THRESHOLD) {
+        _from_base10_chunks(s, n, zero, res);
+        return;
+    }
+
+    std::size_t k = 0;
+    while ((static_cast<std::size_t>(DEC_CHUNK_DIGITS) << (k + 1)) < n) {
+        ++k; // largest power with less digits than s, so lo is at least half
+    }
+    const auto& entry = _pow10_cached(k, false);
+    const auto& pow = entry.pow;
+
+    _limb_vec hi;
+    _limb_vec lo;
+    _from_base10(s, n - entry.digits, zero, &hi);
+    _from_base10(s + (n - entry.digits), entry.digits, zero, &lo);
+
+    if (hi.empty()) {
+        *res = std::move(lo);
+        return;
+    }
+
+    // res = hi * pow + lo, lo < pow so no carry out
+    res->resize(hi.size() + pow.size());
+    _limbs_mul(res->data(), hi.data(), hi.size(), pow.data(), pow.size());
+    _limbs_add(res->data(), res->data(), res->size(), lo.data(), lo.size());
+    res->resize(_limbs_norm(res->data(), res->size()));
+
+}
+
+/**
+ * @brief x = hi * pow + lo using the precomputed reciprocal of pow (Barrett reduction).
+ * 
+ * <p> Requires x < BASE ^ (2 * pow.size) which holds when x < pow^2 </p>
+ * 
+ */
+void _pow10_divrem(const _limb_vec& x, const _pow10_entry& entry, _limb_vec* hi, _limb_vec* lo) {
+
+    const auto& pow = entry.pow;
+    const auto& mu = entry.mu;
+    const auto n = pow.size();
+
+    hi->clear();
+    if (x.size() < n) {
+        *lo = x;
+        return;
+    }
+
+    // q = ((x / BASE^(n - 1)) * mu) / BASE^(n + 1), at most 2 less than the real quotient
+    const auto q1n = x.size() - (n - 1);
+    _limb_vec q2(q1n + mu.size());
+    _limbs_mul(q2.data(), x.data() + (n - 1), q1n, mu.data(), mu.size());
+    if (q2.size() > n + 1) {
+        hi->assign(q2.cbegin() + (n + 1), q2.cend());
+    }
+    hi->resize(_limbs_norm(hi->data(), hi->size()));
+
+    *lo = x;
+    if (!hi->empty()) {
+        _limb_vec qp(hi->size() + n);
+        _limbs_mul(qp.data(), hi->data(), hi->size(), pow.data(), n);
+        _limbs_sub(lo->data(), lo->data(), lo->size(), qp.data(), _limbs_norm(qp.data(), qp.size()));
+    }
+    lo->resize(_limbs_norm(lo->data(), lo->size()));
+
+    while (_limbs_cmp(lo->data(), lo->size(), pow.data(), n) >= 0) {
+        _limbs_sub(lo->data(), lo->data(), lo->size(), pow.data(), n);
+        lo->resize(_limbs_norm(lo->data(), lo->size()));
+        hi->emplace_back(0);
+        const _limb_vec one(1, 1);
+        _limbs_add(hi->data(), hi->data(), hi->size(), one.data(), 1);
+        hi->resize(_limbs_norm(hi->data(), hi->size()));
+    }
+
+}
+
+/**
+ * @brief Append base10 digits of x to \p out, left padded with 0's to \p pad digits.
+ * 
+ * @param x normalized least significant first digits, is destroyed
+ * @param k x < (10 ^ (DEC_CHUNK_DIGITS * 2^k))^2
+ */
+void _to_base10(_limb_vec&& x, std::size_t k, std::size_t pad, std::string* out) {
+
+    if (x.size() <= DEC_CONVERSION_THRESHOLD) {
+        std::string digits; // least significant first
+        auto n = x.size();
+        while (n != 0) {
+            _limb chunk = _limbs_divrem_1(x.data(), x.data(), n, DEC_CHUNK);
+            n = _limbs_norm(x.data(), n);
+            for (_ui i = 0; i != DEC_CHUNK_DIGITS && (n != 0 || chunk != 0); ++i) { // no leading 0's for top chunk
+                digits.push_back(static_cast<char>('0' + (chunk % 10)));
+                chunk /= 10;
+            }
+        }
+        if (digits.size() < pad) {
+            out->append(pad - digits.size(), '0');
+        }
+        out->append(digits.crbegin(), digits.crend());
+        return;
+    }
+
+    // x < pow^2 so split x = hi * pow + lo, both less than pow
+    const auto& entry = _pow10_cached(k);
+    const auto lo_digits = entry.digits;
+    _limb_vec hi;
+    _limb_vec lo;
+    _pow10_divrem(x, entry, &hi, &lo);
+    x = _limb_vec();
+
+    if (hi.empty()) { // x < pow so lo is the whole number
+        _to_base10(std::move(lo), k - 1, pad, out);
+        return;
+    }
+
+    _to_base10(std::move(hi), k - 1, pad > lo_digits ? pad - lo_digits : 0, out);
+    _to_base10(std::move(lo), k - 1, lo_digits, out);
+
+}
+
+/**
+ * @brief <b> Quick </b> - theta(log(num.digits.size) * operator*). Convert \p BigUnsigned to base10 string.
+ * 
+ * <p> Splits the number in half by cached powers of 10 (divide and conquer), pieces
+ *     with at most \p DEC_CONVERSION_THRESHOLD digits are converted a chunk of
+ *     \p DEC_CHUNK_DIGITS base10 digits at a time.
+ * </p>
+ * 
+ */
+std::string BigUnsigned_10_str(const BigUnsigned& num) {
+
+    if (num.digits.empty()) {
+        return "0";
+    }
+
+    auto x = num.digits;
+
+    std::size_t k = 0;
+    while (x.size() > DEC_CONVERSION_THRESHOLD && 2 * (_pow10_cached(k, false).pow.size() - 1) < x.size()) {
+        ++k; // smallest k where x < BASE^(2 * (pow.size - 1)) <= pow^2
+    }
+
+    std::string res;
+    res.reserve(static_cast<std::size_t>(x.size() * BASE_BIN_LENGTH * 0.30103) + 1);
+    _to_base10(std::move(x), k, 0, &res);
+
+    return res;
+
+}
+
+/**
+ * @brief Convert \p BigUnsigned to a container of base10 digits.
+ * 
+ * <p> Prefer \p BigUnsigned_10_str when a string is wanted. </p>
+ * 
+ */
+BigUnsigned::cont_ull BigUnsigned_10(const BigUnsigned& num) {
+
+    const auto str = BigUnsigned_10_str(num);
+
+    BigUnsigned::cont_ull res(str.size());
+    std::transform(str.cbegin(), str.cend(), res.begin(), [](char c) {
+        return static_cast<BigUnsigned::cont_ull::value_type>(c - '0');
+    });
+
+    return res;
+
+}
+
+/**
+ * @brief If possible return \p BigUnsigned as double value. 
+ * 
+ * <p> Use \p BigUnsigned_10 function for guarnteed accuracy. </p>
+ * 
+ * @return -1 if exceeds double without loss precision
+ */
+double BigUnsigned_10_dbl(const BigUnsigned& num) {
+
+    if (num.digits.size() > DOUBLE_CONVERSION) {
+        return -1;
+    }
+
+    double res = 0.0;
+    double i = 0;
+    for (auto iter = num.digits.cbegin(); iter != num.digits.cend(); ++iter) {
+        res += pow(static_cast<double>(BASE), i) * static_cast<double>(*iter);
+        ++i;
+    }
+
+    return res;
+
+}
+// conversion to double ------------------------
+
+/**
+ * @brief Bits [lo, lo + 64) of \p q, \p lo may be negative to shift left.
+ * 
+ */
+std::uint64_t _limbs_bits64(const _limb* q, std::size_t qn, long long lo) {
+
+    std::uint64_t res = 0;
+    const long long width = BASE_BIN_LENGTH;
+    for (std::size_t j = lo > 0 ? static_cast<std::size_t>(lo / width) : 0; j < qn; ++j) {
+        const long long off = static_cast<long long>(j) * width - lo; // bit 0 of q[j] in res
+        if (off >= 64) {
+            break;
+        }
+        const std::uint64_t digit = q[j];
+        res |= off >= 0 ? digit << off : digit >> -off;
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief true if any of bits [0, lo) of \p q are set.
+ * 
+ */
+bool _limbs_any_below(const _limb* q, std::size_t qn, long long lo) {
+
+    if (lo <= 0) {
+        return false;
+    }
+
+    const auto whole = std::min(qn, static_cast<std::size_t>(lo / BASE_BIN_LENGTH));
+    for (std::size_t j = 0; j != whole; ++j) {
+        if (q[j] != 0) {
+            return true;
+        }
+    }
+
+    const auto part = static_cast<_ui>(lo % BASE_BIN_LENGTH);
+    return whole < qn && part != 0 && (q[whole] & ((static_cast<_limb>(1) << part) - 1)) != 0;
+
+}
+
+/**
+ * @brief Round (q + sticky) * 2^exp2 to the nearest double, ties to even.
+ *        q is normalized and non zero, \p sticky means something non zero below q.
+ * 
+ * <p> Only the top 64 bits of q are read unless the value is exactly halfway. Results
+ *     smaller than half the smallest subnormal are 0, too large are infinity.
+ * </p>
+ * 
+ * @param near_tie if not null set to true when the value is within 3 units of the
+ *                 last 64 bits of q from a halfway point
+ */
+double _limbs_to_double(const _limb* q, std::size_t qn, long long exp2, bool sticky, bool* near_tie = nullptr) {
+
+    const long long bits = static_cast<long long>(qn - 1) * BASE_BIN_LENGTH + _limb_bit_length(q[qn - 1]);
+    const long long lo = bits - 64;
+    const std::uint64_t top = _limbs_bits64(q, qn, lo); // leading bit at 63
+    const long long exp = exp2 + bits - 1; // value in [2^exp, 2^(exp + 1))
+
+    int prec = std::numeric_limits<double>::digits;
+    const int exp_min = std::numeric_limits<double>::min_exponent - 1; // smallest normal 2^exp_min
+    if (exp < exp_min) {
+        prec -= static_cast<int>(std::min<long long>(exp_min - exp, prec + 1));
+    }
+
+    if (prec < 0) {
+        if (near_tie != nullptr) {
+            *near_tie = false;
+        }
+        return 0.0;
+    }
+
+    // keep prec bits, the rest decide rounding
+    const std::uint64_t keep = prec == 0 ? 0 : top >> (64 - prec);
+    const std::uint64_t rest = prec == 0 ? top : top & ((~static_cast<std::uint64_t>(0)) >> prec);
+    const std::uint64_t half = static_cast<std::uint64_t>(1) << (63 - prec);
+
+    if (near_tie != nullptr) {
+        *near_tie = (rest > half ? rest - half : half - rest) <= 3;
+    }
+
+    bool up = rest > half;
+    if (rest == half) {
+        up = sticky || _limbs_any_below(q, qn, lo) || (keep & 1) != 0;
+    }
+
+    return std::ldexp(static_cast<double>(keep + up), static_cast<int>(std::max<long long>(std::min<long long>(exp - prec + 1, INT_MAX / 2), INT_MIN / 2)));
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1). \p num as the nearest double, infinity if too large.
+ * 
+ * <p> Reads the top digits plus the exponent, so unlike \p BigUnsigned_10_dbl works for any size. </p>
+ * 
+ */
+double to_double(const BigUnsigned& num) {
+
+    if (num.digits.empty()) {
+        return 0.0;
+    }
+
+    return _limbs_to_double(num.digits.data(), num.digits.size(), 0, false);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1) nearly always. num / den as the nearest double, digits
+ *        least significant first and normalized.
+ * 
+ * <p> Divides only the leading digits, with enough of den that the quotient is off by
+ *     less than 2 in its last of at least 64 bits. Then it rounds the same as the exact
+ *     quotient unless it is within 3 of a halfway point, only then is the exact
+ *     quotient computed.
+ * </p>
+ * <p> The windows are a few digits, so only the exact case takes storage. </p>
+ * 
+ */
+double _limbs_ratio_to_double(const _limb* num, std::size_t num_n, const _limb* den, std::size_t den_n) {
+
+    assert(den_n != 0 && "division by 0");
+
+    if (num_n == 0) {
+        return 0.0;
+    }
+
+    constexpr std::size_t quot_len = 64 / BASE_BIN_LENGTH + 1; // quotient >= 2^64
+    constexpr std::size_t den_len = quot_len + 2; // den window > quotient * BASE
+
+    const std::size_t dl = std::min(den_n, den_len);
+    const std::size_t nl = dl + quot_len;
+
+    // num = N * BASE^cn + ..., den = D * BASE^cd + ..., num / den ~ N / D * BASE^(cn - cd)
+    const long long cn = static_cast<long long>(num_n) - static_cast<long long>(nl);
+    const long long cd = static_cast<long long>(den_n - dl);
+
+    _limb n_win[den_len + quot_len] = {}; // windows are bounded, keep them off the heap
+    if (cn >= 0) {
+        std::copy(num + cn, num + num_n, n_win);
+    } else {
+        std::copy(num, num + num_n, n_win - cn);
+    }
+    const _limb* d_win = den + cd;
+
+    _limb q[quot_len + 1] = {};
+    bool rem = false;
+    if (dl == 1) {
+        rem = _limbs_divrem_1(q, n_win, nl, d_win[0]) != 0;
+    } else {
+        _limb r[den_len];
+        _limbs_divrem(q, r, n_win, nl, d_win, dl);
+        rem = _limbs_norm(r, dl) != 0;
+    }
+    const auto qn = _limbs_norm(q, nl - dl + 1);
+
+    const bool truncated = cn > 0 || cd > 0;
+    const long long exp2 = (cn - cd) * BASE_BIN_LENGTH;
+
+    bool near_tie = false;
+    double res = _limbs_to_double(q, qn, exp2, rem || truncated, &near_tie);
+    if (!near_tie || !truncated) {
+        return res;
+    }
+
+    // exact quotient at the same scale, num * BASE^-cn / (den * BASE^-cd)
+    const auto shift = static_cast<std::size_t>(cn < cd ? cd - cn : cn - cd);
+    BigUnsigned n_exact(num_n + (cn < cd ? shift : 0));
+    BigUnsigned d_exact(den_n + (cn < cd ? 0 : shift));
+    std::copy(num, num + num_n, n_exact.digits.end() - num_n);
+    std::copy(den, den + den_n, d_exact.digits.end() - den_n);
+
+    auto exact = divmod(n_exact, d_exact);
+
+    return _limbs_to_double(exact.first.digits.data(), exact.first.digits.size(), exp2, !exact.second.digits.empty());
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1) nearly always. num / den as the nearest double,
+ *        see \p _limbs_ratio_to_double.
+ * 
+ */
+double ratio_to_double(const BigUnsigned& num, const BigUnsigned& den) {
+
+    return _limbs_ratio_to_double(num.digits.data(), num.digits.size(), den.digits.data(), den.digits.size());
+
+}
@@ -0,0 +1,579 @@
+// Author: Dennis Yakovlev
+
+// File containing members relating to the memory used by BigUnsigned digits.
+// Small numbers keep their digits inline, larger ones get them from a std::pmr
+//     memory resource. A request_arena can be installed for the duration of a
+//     request so those allocations come from one buffer which is reset afterwards.
+
+#pragma once
+#include <algorithm>
+#include <BigInt_vars.h>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * @brief Number of digits stored inside the number before allocating.
+ *        Enough for every path count of a 99 x 99 grid with 64 bit digits.
+ *
+ */
+constexpr std::size_t INLINE_LIMBS = 32 / sizeof(_limb);
+
+/**
+ * @brief Default size in bytes of the buffer of a \p request_arena.
+ *
+ */
+constexpr std::size_t ARENA_BUFFER_SIZE = 1 << 18;
+
+/**
+ * @brief Counters of digit storage requests.
+ *
+ * <p> requested is how many allocations a plain std::vector would have made, heap is
+ *     how many actually reached the heap. The rest were served inline or by an arena.
+ * </p>
+ *
+ */
+struct alloc_stats {
+
+    std::size_t requested = 0; // storage needed, would have been an allocation
+    std::size_t inlined = 0; // fit inside the number
+    std::size_t arena = 0; // served by an arena
+    std::size_t heap = 0; // reached the heap, arena buffer refills included
+
+    /**
+     * @brief Number of allocations saved compared to always allocating.
+     *
+     */
+    std::size_t saved() const {
+
+        return requested > heap ? requested - heap : 0;
+
+    }
+
+    alloc_stats operator- (const alloc_stats& r) const {
+
+        alloc_stats res;
+        res.requested = requested - r.requested;
+        res.inlined = inlined - r.inlined;
+        res.arena = arena - r.arena;
+        res.heap = heap - r.heap;
+
+        return res;
+
+    }
+
+};
+
+/**
+ * @brief Counters for the current thread since it started.
+ *
+ */
+thread_local alloc_stats bigint_alloc_stats;
+
+/**
+ * @brief Heap resource which counts its allocations in \p bigint_alloc_stats.
+ *
+ */
+class _counting_resource : public std::pmr::memory_resource {
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+
+        ++bigint_alloc_stats.heap;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+
+        return this == &other;
+
+    }
+
+};
+
+_counting_resource _heap_resource;
+
+/**
+ * @brief Resource new digit storage is taken from on this thread.
+ *
+ */
+thread_local std::pmr::memory_resource* _bigint_resource = &_heap_resource;
+
+/**
+ * @brief Resource digits are currently allocated from on this thread.
+ *
+ */
+inline std::pmr::memory_resource* bigint_resource() {
+
+    return _bigint_resource;
+
+}
+
+/**
+ * @brief Counting heap resource, the default of every thread.
+ *
+ */
+inline std::pmr::memory_resource* bigint_heap_resource() {
+
+    return &_heap_resource;
+
+}
+
+/**
+ * @brief Set resource new digit storage is taken from on this thread for the lifetime of the scope.
+ *
+ * <p> Use with \p bigint_heap_resource around values which outlive a request, such as caches. </p>
+ *
+ */
+class resource_scope {
+
+public:
+
+    explicit resource_scope(std::pmr::memory_resource* res) : _prev(_bigint_resource) {
+
+        _bigint_resource = res;
+
+    }
+
+    resource_scope(const resource_scope&) = delete;
+    resource_scope& operator= (const resource_scope&) = delete;
+
+    ~resource_scope() {
+
+        _bigint_resource = _prev;
+
+    }
+
+private:
+
+    std::pmr::memory_resource* _prev;
+
+};
+
+/**
+ * @brief Monotonic resource which counts the allocations it serves.
+ *
+ */
+class _arena_resource : public std::pmr::monotonic_buffer_resource {
+
+public:
+
+    using std::pmr::monotonic_buffer_resource::monotonic_buffer_resource;
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+
+        ++bigint_alloc_stats.arena;
+        return std::pmr::monotonic_buffer_resource::do_allocate(bytes, align);
+
+    }
+
+};
+
+/**
+ * @brief Arena for the digits of a single request.
+ *
+ * <p> Owns a buffer allocated once, requests bump allocate from it and only reach
+ *     the heap if it runs out. \p reset frees everything at once. Meant to be kept
+ *     around and reused for every request, see \p arena_scope.
+ * </p>
+ *
+ */
+class request_arena {
+
+public:
+
+    explicit request_arena(std::size_t buffer_size = ARENA_BUFFER_SIZE) :
+        _buffer(std::make_unique<std::byte[]>(buffer_size)),
+        _arena(_buffer.get(), buffer_size, &_heap_resource),
+        _start(bigint_alloc_stats) {}
+
+    request_arena(const request_arena&) = delete;
+    request_arena& operator= (const request_arena&) = delete;
+
+    /**
+     * @brief Release all memory handed out. No number allocated from the arena may be used after.
+     *
+     */
+    void reset() {
+
+        _arena.release();
+        _last = stats();
+        _start = bigint_alloc_stats;
+
+    }
+
+    /**
+     * @brief Counters of this thread since construction or the last \p reset.
+     *
+     */
+    alloc_stats stats() const {
+
+        return bigint_alloc_stats - _start;
+
+    }
+
+    /**
+     * @brief Counters of this thread between the last two resets, which is the last
+     *        finished request when every request is an \p arena_scope.
+     *
+     */
+    alloc_stats last_stats() const {
+
+        return _last;
+
+    }
+
+    std::pmr::memory_resource* resource() {
+
+        return &_arena;
+
+    }
+
+private:
+
+    std::unique_ptr<std::byte[]> _buffer;
+    _arena_resource _arena;
+    alloc_stats _start;
+    alloc_stats _last;
+
+};
+
+/**
+ * @brief Take digit storage from \p arena for the lifetime of the scope and reset
+ *        the arena at the end of it.
+ *
+ * <p> Numbers created inside the scope must not be used after it ends. Values assigned
+ *     to numbers created outside of the scope are copied into their own storage.
+ * </p>
+ *
+ */
+class arena_scope {
+
+public:
+
+    explicit arena_scope(request_arena* arena) : _arena(arena), _resource(arena->resource()) {}
+
+    arena_scope(const arena_scope&) = delete;
+    arena_scope& operator= (const arena_scope&) = delete;
+
+    ~arena_scope() {
+
+        _arena->reset();
+
+    }
+
+private:
+
+    request_arena* _arena;
+    resource_scope _resource;
+
+};
+
+/**
+ * @brief Digit container of BigUnsigned. Works like a std::vector of digits
+ *        with \p INLINE_LIMBS digits of inline storage.
+ *
+ * <p> Heap storage comes from the thread's \p bigint_resource at the time of construction,
+ *     and stays with that resource like a std::pmr container. Move construction steals
+ *     the storage, move assignment only does when both use the same resource and copies otherwise.
+ * </p>
+ *
+ */
+class _limb_storage {
+
+public:
+
+    using value_type = _limb;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = _limb&;
+    using const_reference = const _limb&;
+    using pointer = _limb*;
+    using const_pointer = const _limb*;
+    using iterator = _limb*;
+    using const_iterator = const _limb*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    _limb_storage() noexcept : _res(_bigint_resource), _data(_inline), _size(0), _cap(INLINE_LIMBS) {}
+
+    explicit _limb_storage(std::pmr::memory_resource* res) noexcept : _res(res), _data(_inline), _size(0), _cap(INLINE_LIMBS) {}
+
+    explicit _limb_storage(size_type n, _limb val = 0) : _limb_storage() {
+
+        resize(n, val);
+
+    }
+
+    template<typename Input, typename = typename std::iterator_traits<Input>::iterator_category>
+    _limb_storage(Input first, Input last) : _limb_storage() {
+
+        assign(first, last);
+
+    }
+
+    _limb_storage(const _limb_storage& other) : _limb_storage() {
+
+        assign(other.cbegin(), other.cend());
+
+    }
+
+    _limb_storage(_limb_storage&& other) noexcept : _res(other._res), _data(_inline), _size(0), _cap(INLINE_LIMBS) {
+
+        _take(&other);
+
+    }
+
+    _limb_storage& operator= (const _limb_storage& other) {
+
+        if (this != &other) {
+            assign(other.cbegin(), other.cend());
+        }
+
+        return *this;
+
+    }
+
+    _limb_storage& operator= (_limb_storage&& other) {
+
+        if (this == &other) {
+            return *this;
+        }
+
+        if (other._on_heap() && _res->is_equal(*other._res)) {
+            _release();
+            _take(&other);
+        } else {
+            assign(other.cbegin(), other.cend());
+            other.clear();
+        }
+
+        return *this;
+
+    }
+
+    ~_limb_storage() {
+
+        _release();
+
+    }
+
+    iterator begin() noexcept { return _data; }
+    const_iterator begin() const noexcept { return _data; }
+    const_iterator cbegin() const noexcept { return _data; }
+    iterator end() noexcept { return _data + _size; }
+    const_iterator end() const noexcept { return _data + _size; }
+    const_iterator cend() const noexcept { return _data + _size; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+    size_type size() const noexcept { return _size; }
+    size_type capacity() const noexcept { return _cap; }
+    bool empty() const noexcept { return _size == 0; }
+    _limb* data() noexcept { return _data; }
+    const _limb* data() const noexcept { return _data; }
+
+    reference operator[] (size_type i) { return _data[i]; }
+    const_reference operator[] (size_type i) const { return _data[i]; }
+    reference front() { return _data[0]; }
+    const_reference front() const { return _data[0]; }
+    reference back() { return _data[_size - 1]; }
+    const_reference back() const { return _data[_size - 1]; }
+
+    std::pmr::memory_resource* resource() const noexcept { return _res; }
+
+    void reserve(size_type n) {
+
+        _count_first_use(n);
+        if (n > _cap) {
+            _grow(n);
+        }
+
+    }
+
+    void resize(size_type n, _limb val = 0) {
+
+        _count_first_use(n);
+        if (n > _cap) {
+            _grow(std::max(n, 2 * _cap));
+        }
+        if (n > _size) {
+            std::fill(_data + _size, _data + n, val);
+        }
+        _size = n;
+
+    }
+
+    void clear() noexcept {
+
+        _size = 0;
+
+    }
+
+    reference emplace_back(_limb val) {
+
+        if (_size == _cap) {
+            _grow(2 * _cap);
+        }
+        _count_first_use(_size + 1);
+        _data[_size] = val;
+
+        return _data[_size++];
+
+    }
+
+    void push_back(_limb val) {
+
+        emplace_back(val);
+
+    }
+
+    void pop_back() noexcept {
+
+        --_size;
+
+    }
+
+    template<typename Input>
+    void assign(Input first, Input last) {
+
+        const auto n = static_cast<size_type>(std::distance(first, last));
+        reserve(n);
+        std::copy(first, last, _data);
+        _size = n;
+
+    }
+
+    void assign(size_type n, _limb val) {
+
+        reserve(n);
+        std::fill(_data, _data + n, val);
+        _size = n;
+
+    }
+
+    /**
+     * @brief Swap contents. Storage is exchanged when both use the same resource, otherwise copied.
+     *
+     */
+    void swap(_limb_storage& other) {
+
+        if (_on_heap() && other._on_heap() && _res->is_equal(*other._res)) {
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            std::swap(_cap, other._cap);
+            return;
+        }
+
+        _limb_storage tmp(_res);
+        tmp.assign(cbegin(), cend());
+        assign(other.cbegin(), other.cend());
+        other.assign(tmp.cbegin(), tmp.cend());
+
+    }
+
+    bool operator== (const _limb_storage& r) const {
+
+        return _size == r._size && std::equal(cbegin(), cend(), r.cbegin());
+
+    }
+
+    bool operator!= (const _limb_storage& r) const {
+
+        return !(*this == r);
+
+    }
+
+private:
+
+    bool _on_heap() const noexcept {
+
+        return _data != _inline;
+
+    }
+
+    /**
+     * @brief A std::vector allocates the first time it holds anything, count that
+     *        request when it is served inline.
+     *
+     */
+    void _count_first_use(size_type n) {
+
+        if (_size == 0 && n != 0 && !_on_heap() && !_used) {
+            _used = true;
+            if (n <= INLINE_LIMBS) {
+                ++bigint_alloc_stats.requested;
+                ++bigint_alloc_stats.inlined;
+            }
+        }
+
+    }
+
+    void _grow(size_type cap) {
+
+        ++bigint_alloc_stats.requested;
+        _used = true;
+
+        auto data_new = static_cast<_limb*>(_res->allocate(cap * sizeof(_limb), alignof(_limb)));
+        std::copy(_data, _data + _size, data_new);
+        _release();
+        _data = data_new;
+        _cap = cap;
+
+    }
+
+    void _release() noexcept {
+
+        if (_on_heap()) {
+            _res->deallocate(_data, _cap * sizeof(_limb), alignof(_limb));
+            _data = _inline;
+            _cap = INLINE_LIMBS;
+        }
+
+    }
+
+    /**
+     * @brief Take the contents of \p other, requires this holds no heap storage.
+     *
+     */
+    void _take(_limb_storage* other) noexcept {
+
+        _res = other->_res;
+        _used = other->_used;
+        if (other->_on_heap()) {
+            _data = other->_data;
+            _cap = other->_cap;
+        } else {
+            std::copy(other->_data, other->_data + other->_size, _inline);
+            _data = _inline;
+            _cap = INLINE_LIMBS;
+        }
+        _size = other->_size;
+
+        other->_data = other->_inline;
+        other->_cap = INLINE_LIMBS;
+        other->_size = 0;
+
+    }
+
+    std::pmr::memory_resource* _res;
+    _limb* _data;
+    size_type _size;
+    size_type _cap;
+    bool _used = false;
+    _limb _inline[INLINE_LIMBS];
+
+};
@@ -0,0 +1,585 @@
+// Author: Dennis Yakovlev
+
+// File containing FixedUnsigned, an unsigned integer of at most a fixed number of digits
+//     stored inline, for values with a known bound like path counts of a bounded grid.
+
+#pragma once
+#include <algorithm>
+#include <BigInt.h>
+#include <BigInt_limbs.h>
+#include <BigInt_vars.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Call f(std::integral_constant<std::size_t, I>) for I in [0, N), unrolled at compile time.
+ *
+ */
+template<typename F, std::size_t... I>
+constexpr void _unroll_seq(F&& f, std::index_sequence<I...>) {
+
+    (f(std::integral_constant<std::size_t, I>{}), ...);
+
+}
+
+template<std::size_t N, typename F>
+constexpr void _unroll(F&& f) {
+
+    _unroll_seq(std::forward<F>(f), std::make_index_sequence<N>{});
+
+}
+
+/**
+ * @brief Digits needed to hold \p bits binary digits.
+ *
+ */
+constexpr std::size_t fixed_limbs(std::size_t bits) {
+
+    return (bits + BASE_BIN_LENGTH - 1) / BASE_BIN_LENGTH;
+
+}
+
+/**
+ * @brief Digit container of FixedUnsigned. Works like a std::vector of at most N digits
+ *        with all of them stored inline, never allocates.
+ *
+ * <p> Digits past size() are always 0, so arithmetic can run over all N digits
+ *     without looking at the size.
+ * </p>
+ *
+ */
+template<std::size_t N>
+class _fixed_digits {
+
+public:
+
+    using value_type = _limb;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = _limb&;
+    using const_reference = const _limb&;
+    using pointer = _limb*;
+    using const_pointer = const _limb*;
+    using iterator = _limb*;
+    using const_iterator = const _limb*;
+
+    constexpr _fixed_digits() noexcept : _data{}, _size(0) {}
+
+    constexpr explicit _fixed_digits(size_type n, _limb val = 0) : _data{}, _size(0) {
+
+        resize(n, val);
+
+    }
+
+    constexpr iterator begin() noexcept { return _data; }
+    constexpr const_iterator begin() const noexcept { return _data; }
+    constexpr const_iterator cbegin() const noexcept { return _data; }
+    constexpr iterator end() noexcept { return _data + _size; }
+    constexpr const_iterator end() const noexcept { return _data + _size; }
+    constexpr const_iterator cend() const noexcept { return _data + _size; }
+
+    constexpr size_type size() const noexcept { return _size; }
+    static constexpr size_type capacity() noexcept { return N; }
+    constexpr bool empty() const noexcept { return _size == 0; }
+    constexpr _limb* data() noexcept { return _data; }
+    constexpr const _limb* data() const noexcept { return _data; }
+
+    constexpr reference operator[] (size_type i) { return _data[i]; }
+    constexpr const_reference operator[] (size_type i) const { return _data[i]; }
+    constexpr reference front() { return _data[0]; }
+    constexpr const_reference front() const { return _data[0]; }
+    constexpr reference back() { return _data[_size - 1]; }
+    constexpr const_reference back() const { return _data[_size - 1]; }
+
+    constexpr void resize(size_type n, _limb val = 0) {
+
+        assert(n <= N && "FixedUnsigned out of digits");
+        for (size_type i = _size; i < n; ++i) {
+            _data[i] = val;
+        }
+        for (size_type i = n; i < _size; ++i) {
+            _data[i] = 0;
+        }
+        _size = n;
+
+    }
+
+    constexpr void clear() noexcept {
+
+        resize(0);
+
+    }
+
+    constexpr reference emplace_back(_limb val) {
+
+        assert(_size < N && "FixedUnsigned out of digits");
+        _data[_size] = val;
+
+        return _data[_size++];
+
+    }
+
+    constexpr void push_back(_limb val) {
+
+        emplace_back(val);
+
+    }
+
+    /**
+     * @brief Set the size to the digits up to the most significant non zero one.
+     *
+     */
+    constexpr void _normalize() noexcept {
+
+        size_type n = 0;
+        _unroll<N>([&](auto i) {
+            if (_data[i] != 0) {
+                n = i + 1;
+            }
+        });
+        _size = n;
+
+    }
+
+private:
+
+    _limb _data[N];
+    size_type _size;
+
+};
+
+/**
+ * @brief Unsigned integer of at most N digits kept inline, for values with a known bound.
+ *
+ * <p> Same layout of digits as \p BigUnsigned (least significant first, no leading 0's),
+ *     so code only reading \p digits works on either. Arithmetic runs over all N digits
+ *     with the loops unrolled, and can be evaluated at compile time. Results must fit
+ *     in N digits, which is asserted.
+ * </p>
+ *
+ */
+template<std::size_t N>
+class FixedUnsigned {
+    // call resize_to_fit to ensure leading zeros are gone is using sz_ty_ull constructor
+public:
+
+    static_assert(N != 0, "FixedUnsigned needs at least one digit");
+
+    using cont_ull = _fixed_digits<N>;
+    using sz_ty_ull = typename cont_ull::size_type;
+
+    /**
+     * @brief Maximum number of digits.
+     *
+     */
+    static constexpr std::size_t limbs = N;
+
+    constexpr FixedUnsigned() : digits() {}
+
+    /**
+     * @brief <b> Fast </b> - theta(N). Construct from the value of a native unsigned integer.
+     *
+     */
+    template<typename Integral, typename = _integral_unsigned<Integral>>
+    constexpr explicit FixedUnsigned(Integral num, NATIVE) : digits() {
+
+        if constexpr (sizeof(Integral) <= sizeof(_limb)) {
+            if (num != 0) {
+                digits.emplace_back(static_cast<_limb>(num));
+            }
+        } else {
+            for (; num != 0; num >>= BASE_BIN_LENGTH) {
+                digits.emplace_back(static_cast<_limb>(num));
+            }
+        }
+
+    }
+
+    /**
+     * @brief Construct a new empty Fixed Unsigned object from size type.
+     *
+     */
+    constexpr explicit FixedUnsigned(sz_ty_ull size) : digits(size, 0) {}
+
+    /**
+     * @brief Construct from a \p BigUnsigned that fits in N digits.
+     *
+     */
+    explicit FixedUnsigned(const BigUnsigned& num) : digits(num.digits.size(), 0) {
+
+        std::copy(num.digits.cbegin(), num.digits.cend(), digits.begin());
+
+    }
+
+    /**
+     * @brief Remove the leading 0's.
+     *
+     */
+    constexpr void resize_to_fit() {
+
+        digits._normalize();
+
+    }
+
+    /**
+     * @brief Container containing digits of number. Least significant first.
+     *
+     */
+    cont_ull digits;
+
+};
+
+/**
+ * @brief Output raw digits, most significant first.
+ */
+template<std::size_t N>
+std::ostream& operator<< (std::ostream& out, const FixedUnsigned<N>& num) {
+
+    for (auto iter = num.digits.cend(); iter != num.digits.cbegin();) {
+        out << *--iter << ", ";
+    }
+    return out;
+
+}
+
+/**
+ * @brief Whether T is a \p FixedUnsigned.
+ *
+ */
+template<typename T>
+struct _is_fixed_unsigned : std::false_type {};
+
+template<std::size_t N>
+struct _is_fixed_unsigned<FixedUnsigned<N>> : std::true_type {};
+
+template<typename T> constexpr bool _is_fixed_unsigned_v = _is_fixed_unsigned<T>::value;
+
+/**
+ * @brief <b> Fast </b> - theta(N). Copy into a \p BigUnsigned.
+ *
+ */
+template<std::size_t N>
+BigUnsigned to_BigUnsigned(const FixedUnsigned<N>& num) {
+
+    BigUnsigned res(num.digits.size());
+    std::copy(num.digits.cbegin(), num.digits.cend(), res.digits.begin());
+
+    return res;
+
+}
+
+// comparison ----------------------------------
+
+/**
+ * @brief -1, 0, 1 for l < r, l == r, l > r.
+ *
+ */
+template<std::size_t N>
+constexpr int _fixed_cmp(const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    int res = 0;
+    _unroll<N>([&](auto i) {
+        constexpr std::size_t j = N - 1 - decltype(i)::value;
+        if (res == 0 && l.digits[j] != r.digits[j]) {
+            res = l.digits[j] < r.digits[j] ? -1 : 1;
+        }
+    });
+
+    return res;
+
+}
+
+template<std::size_t N>
+constexpr bool operator< (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return _fixed_cmp(l, r) < 0;
+
+}
+
+template<std::size_t N>
+constexpr bool operator> (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return _fixed_cmp(l, r) > 0;
+
+}
+
+template<std::size_t N>
+constexpr bool operator<= (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return _fixed_cmp(l, r) <= 0;
+
+}
+
+template<std::size_t N>
+constexpr bool operator>= (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return _fixed_cmp(l, r) >= 0;
+
+}
+
+template<std::size_t N>
+constexpr bool operator== (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return _fixed_cmp(l, r) == 0;
+
+}
+
+template<std::size_t N>
+constexpr bool operator!= (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return _fixed_cmp(l, r) != 0;
+
+}
+
+// arithmetic ----------------------------------
+
+/**
+ * @brief <b> Fast </b> - theta(N)
+ *
+ */
+template<std::size_t N>
+constexpr FixedUnsigned<N>& operator+= (FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    _limb carry = 0;
+    _unroll<N>([&](auto i) {
+        const _dlimb cur = static_cast<_dlimb>(l.digits[i]) + r.digits[i] + carry;
+        l.digits[i] = static_cast<_limb>(cur);
+        carry = static_cast<_limb>(cur >> BASE_BIN_LENGTH);
+    });
+    assert(carry == 0 && "sum does not fit FixedUnsigned");
+    l.digits._normalize();
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(N). Assume l >= r.
+ *
+ */
+template<std::size_t N>
+constexpr FixedUnsigned<N>& operator-= (FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    _limb borrow = 0;
+    _unroll<N>([&](auto i) {
+        const _limb cur = l.digits[i] - r.digits[i] - borrow;
+        borrow = (l.digits[i] < r.digits[i]) || (l.digits[i] - r.digits[i] < borrow) ? 1 : 0;
+        l.digits[i] = cur;
+    });
+    assert(borrow == 0 && "left side needs to be larger than right side");
+    l.digits._normalize();
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(N)
+ *
+ */
+template<std::size_t N>
+constexpr FixedUnsigned<N>& operator*= (FixedUnsigned<N>& l, _limb r) {
+
+    _limb carry = 0;
+    _unroll<N>([&](auto i) {
+        const _dlimb cur = static_cast<_dlimb>(l.digits[i]) * r + carry;
+        l.digits[i] = static_cast<_limb>(cur);
+        carry = static_cast<_limb>(cur >> BASE_BIN_LENGTH);
+    });
+    assert(carry == 0 && "product does not fit FixedUnsigned");
+    l.digits._normalize();
+
+    return l;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(N^2). Schoolbook, only the digit products below N are kept.
+ *
+ */
+template<std::size_t N>
+constexpr FixedUnsigned<N> operator* (const FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    FixedUnsigned<N> res(N);
+    _limb over = 0; // anything above N digits
+    _unroll<N>([&](auto i) {
+        _limb carry = 0;
+        _unroll<N>([&](auto j) {
+            constexpr std::size_t k = decltype(i)::value + decltype(j)::value;
+            if constexpr (k < N) {
+                const _dlimb cur = static_cast<_dlimb>(l.digits[i]) * r.digits[j] + res.digits[k] + carry;
+                res.digits[k] = static_cast<_limb>(cur);
+                carry = static_cast<_limb>(cur >> BASE_BIN_LENGTH);
+            } else {
+                over |= carry | ((l.digits[i] != 0 && r.digits[j] != 0) ? 1 : 0);
+                carry = 0;
+            }
+        });
+        over |= carry;
+    });
+    assert(over == 0 && "product does not fit FixedUnsigned");
+    res.digits._normalize();
+
+    return res;
+
+}
+
+template<std::size_t N>
+constexpr FixedUnsigned<N>& operator*= (FixedUnsigned<N>& l, const FixedUnsigned<N>& r) {
+
+    return l = l * r;
+
+}
+
+template<std::size_t N>
+constexpr FixedUnsigned<N> operator+ (FixedUnsigned<N> l, const FixedUnsigned<N>& r) {
+
+    return l += r;
+
+}
+
+template<std::size_t N>
+constexpr FixedUnsigned<N> operator- (FixedUnsigned<N> l, const FixedUnsigned<N>& r) {
+
+    return l -= r;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(N). n = n / d, returns n % d.
+ *
+ * <p> Note: d must not be 0 </p>
+ *
+ */
+template<std::size_t N>
+constexpr _limb _divrem_limb(FixedUnsigned<N>* n, _limb d) {
+
+    assert(d != 0 && "division by 0");
+
+    _limb rem = 0;
+    _unroll<N>([&](auto i) {
+        constexpr std::size_t j = N - 1 - decltype(i)::value;
+        const _dlimb cur = (static_cast<_dlimb>(rem) << BASE_BIN_LENGTH) | n->digits[j];
+        n->digits[j] = static_cast<_limb>(cur / d);
+        rem = static_cast<_limb>(cur % d);
+    });
+    n->digits._normalize();
+
+    return rem;
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(N)
+ *
+ */
+template<std::size_t N>
+constexpr FixedUnsigned<N>& operator/= (FixedUnsigned<N>& l, _limb r) {
+
+    _divrem_limb(&l, r);
+
+    return l;
+
+}
+
+template<std::size_t N>
+constexpr FixedUnsigned<N> operator/ (FixedUnsigned<N> l, _limb r) {
+
+    return l /= r;
+
+}
+
+template<std::size_t N>
+constexpr _limb operator% (FixedUnsigned<N> l, _limb r) {
+
+    return _divrem_limb(&l, r);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1). Number of binary digits of \p num, 0 for 0.
+ *
+ */
+template<std::size_t N>
+inline std::size_t bit_length(const FixedUnsigned<N>& num) {
+
+    if (num.digits.empty()) {
+        return 0;
+    }
+
+    return (num.digits.size() - 1) * BASE_BIN_LENGTH + _limb_bit_length(num.digits.back());
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1)
+ *
+ */
+template<std::size_t N>
+constexpr bool is_odd(const FixedUnsigned<N>& num) {
+
+    return (num.digits[0] & 1) != 0;
+
+}
+
+// conversion ----------------------------------
+
+/**
+ * @brief <b> Fast </b> - theta(1). \p num as the nearest double.
+ *
+ */
+template<std::size_t N>
+double to_double(const FixedUnsigned<N>& num) {
+
+    if (num.digits.empty()) {
+        return 0.0;
+    }
+
+    return _limbs_to_double(num.digits.data(), num.digits.size(), 0, false);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1) nearly always. num / den as the nearest double,
+ *        see \p _limbs_ratio_to_double.
+ *
+ */
+template<std::size_t N>
+double ratio_to_double(const FixedUnsigned<N>& num, const FixedUnsigned<N>& den) {
+
+    return _limbs_ratio_to_double(num.digits.data(), num.digits.size(), den.digits.data(), den.digits.size());
+
+}
+
+/**
+ * @brief <b> Quick </b> - theta(N^2). Convert to base10 string, a chunk of
+ *        \p DEC_CHUNK_DIGITS base10 digits at a time.
+ *
+ */
+template<std::size_t N>
+std::string BigUnsigned_10_str(const FixedUnsigned<N>& num) {
+
+    if (num.digits.empty()) {
+        return "0";
+    }
+
+    char buf[N * BASE_DIGITS]; // filled from the back
+    std::size_t pos = sizeof(buf);
+
+    FixedUnsigned<N> x(num);
+    while (!x.digits.empty()) {
+        auto chunk = _divrem_limb(&x, DEC_CHUNK);
+        for (_ui i = 0; i != DEC_CHUNK_DIGITS && (chunk != 0 || !x.digits.empty()); ++i) {
+            buf[--pos] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+
+    return std::string(buf + pos, buf + sizeof(buf));
+
+}
@@ -0,0 +1,695 @@
+// Author: Dennis Yakovlev
+
+// File containing the innermost digit loops of BigUnsigned arithmetic in several
+//     instruction set variants, and the table of the ones chosen for this cpu.
+// Every variant gives exactly the same results as the scalar one.
+
+#pragma once
+#include <BigInt_vars.h>
+#include <cstddef>
+#include <vector>
+
+#if !defined(BIGINT_NO_DISPATCH) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BIGINT_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+// scalar --------------------------------------
+
+/**
+ * @brief r[0, n) = a[0, n) + b[0, n) + carry. \p r may alias \p a or \p b.
+ *
+ * @return _limb carry out of r[n - 1]
+ */
+_limb _add_n_scalar(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    for (std::size_t i = 0; i != n; ++i) {
+        _limb sum = a[i] + b[i];
+        _limb carry_new = sum < b[i];
+        sum += carry;
+        carry = carry_new | (sum < carry);
+        r[i] = sum;
+    }
+
+    return carry;
+
+}
+
+/**
+ * @brief r[0, n) = a[0, n) - b[0, n) - borrow. \p r may alias \p a or \p b.
+ *
+ * @return _limb borrow out of r[n - 1]
+ */
+_limb _sub_n_scalar(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    for (std::size_t i = 0; i != n; ++i) {
+        _limb diff = a[i] - b[i];
+        _limb borrow_new = a[i] < b[i];
+        r[i] = diff - borrow;
+        borrow = borrow_new | (diff < borrow);
+    }
+
+    return borrow;
+
+}
+
+/**
+ * @brief r[0, n) += a[0, n) * m
+ *
+ * @return _limb digit carried out past r[n - 1]
+ */
+_limb _addmul_1_scalar(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    _limb carry = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        _dlimb res = static_cast<_dlimb>(a[i]) * m + r[i] + carry; // at most BASE^2 - 1
+        carry = static_cast<_limb>(res >> BASE_BIN_LENGTH);
+        r[i] = static_cast<_limb>(res);
+    }
+
+    return carry;
+
+}
+
+/**
+ * @brief r[0, n) = a[0, n) * m. \p r may alias \p a.
+ *
+ * @return _limb digit carried out past r[n - 1]
+ */
+_limb _mul_1_scalar(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    _limb carry = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        _dlimb res = static_cast<_dlimb>(a[i]) * m + carry;
+        carry = static_cast<_limb>(res >> BASE_BIN_LENGTH);
+        r[i] = static_cast<_limb>(res);
+    }
+
+    return carry;
+
+}
+
+/**
+ * @brief Which lanes of a vector add receive a carry.
+ *
+ * <p> \p gen has a bit set for lanes whose sum overflowed, \p prop for lanes whose
+ *     sum is all ones so pass on an incoming carry. Adding gen + (gen | prop) + carry
+ *     as integers propagates carries between bits exactly like between lanes, so
+ *     the carry into lane i is bit i of the sum xor prop. Same for borrows.
+ * </p>
+ *
+ * @param lanes number of lanes, at most 16
+ * @param carry carry into lane 0, set to the carry out of the last lane
+ * @return unsigned mask of lanes to add the carry to
+ */
+inline unsigned _lane_carries(unsigned gen, unsigned prop, unsigned lanes, _limb* carry) {
+
+    const unsigned sum = gen + (gen | prop) + static_cast<unsigned>(*carry);
+    *carry = static_cast<_limb>(sum >> lanes);
+
+    return (sum ^ prop) & ((1u << lanes) - 1);
+
+}
+
+#ifdef BIGINT_X86_DISPATCH
+
+#if BIGINT_LIMB_BITS == 64
+
+// 64 bit digits -------------------------------
+
+__attribute__((target("adx")))
+_limb _add_n_adx(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    using ull = unsigned long long;
+
+    unsigned char c = static_cast<unsigned char>(carry);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c = _addcarryx_u64(c, a[i], b[i], reinterpret_cast<ull*>(r + i));
+        c = _addcarryx_u64(c, a[i + 1], b[i + 1], reinterpret_cast<ull*>(r + i + 1));
+        c = _addcarryx_u64(c, a[i + 2], b[i + 2], reinterpret_cast<ull*>(r + i + 2));
+        c = _addcarryx_u64(c, a[i + 3], b[i + 3], reinterpret_cast<ull*>(r + i + 3));
+    }
+    for (; i != n; ++i) {
+        c = _addcarryx_u64(c, a[i], b[i], reinterpret_cast<ull*>(r + i));
+    }
+
+    return c;
+
+}
+
+__attribute__((target("adx")))
+_limb _sub_n_adx(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    using ull = unsigned long long;
+
+    unsigned char c = static_cast<unsigned char>(borrow);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        c = _subborrow_u64(c, a[i], b[i], reinterpret_cast<ull*>(r + i));
+        c = _subborrow_u64(c, a[i + 1], b[i + 1], reinterpret_cast<ull*>(r + i + 1));
+        c = _subborrow_u64(c, a[i + 2], b[i + 2], reinterpret_cast<ull*>(r + i + 2));
+        c = _subborrow_u64(c, a[i + 3], b[i + 3], reinterpret_cast<ull*>(r + i + 3));
+    }
+    for (; i != n; ++i) {
+        c = _subborrow_u64(c, a[i], b[i], reinterpret_cast<ull*>(r + i));
+    }
+
+    return c;
+
+}
+
+__attribute__((target("bmi2,adx")))
+_limb _addmul_1_mulx(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    using ull = unsigned long long;
+
+    ull carry = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        ull hi;
+        ull lo = _mulx_u64(a[i], m, &hi);
+        unsigned char c = _addcarryx_u64(0, lo, carry, &lo);
+        c += _addcarryx_u64(0, lo, r[i], reinterpret_cast<ull*>(r + i));
+        carry = hi + c; // a * m + r + carry < BASE^2 so no overflow
+    }
+
+    return carry;
+
+}
+
+__attribute__((target("bmi2,adx")))
+_limb _mul_1_mulx(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    using ull = unsigned long long;
+
+    ull carry = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        ull hi;
+        ull lo = _mulx_u64(a[i], m, &hi);
+        carry = hi + _addcarryx_u64(0, lo, carry, reinterpret_cast<ull*>(r + i));
+    }
+
+    return carry;
+
+}
+
+__attribute__((target("avx2")))
+_limb _add_n_avx2(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m256i shifts = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i sum = _mm256_add_epi64(va, vb);
+        __m256i gen = _mm256_cmpgt_epi64(_mm256_xor_si256(va, sign), _mm256_xor_si256(sum, sign)); // sum < a
+        __m256i prop = _mm256_cmpeq_epi64(sum, ones);
+        unsigned mask = _lane_carries(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(gen))),
+                                      static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(prop))), 4, &carry);
+        __m256i add = _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(mask), shifts), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_add_epi64(sum, add));
+    }
+
+    return _add_n_scalar(r + i, a + i, b + i, n - i, carry);
+
+}
+
+__attribute__((target("avx2")))
+_limb _sub_n_avx2(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i shifts = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i diff = _mm256_sub_epi64(va, vb);
+        __m256i gen = _mm256_cmpgt_epi64(_mm256_xor_si256(vb, sign), _mm256_xor_si256(va, sign)); // a < b
+        __m256i prop = _mm256_cmpeq_epi64(diff, zero);
+        unsigned mask = _lane_carries(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(gen))),
+                                      static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(prop))), 4, &borrow);
+        __m256i sub = _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(mask), shifts), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_sub_epi64(diff, sub));
+    }
+
+    return _sub_n_scalar(r + i, a + i, b + i, n - i, borrow);
+
+}
+
+__attribute__((target("avx512f")))
+_limb _add_n_avx512(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    const __m512i ones = _mm512_set1_epi64(-1);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i sum = _mm512_add_epi64(va, _mm512_loadu_si512(b + i));
+        unsigned mask = _lane_carries(_mm512_cmplt_epu64_mask(sum, va), _mm512_cmpeq_epi64_mask(sum, ones), 8, &carry);
+        _mm512_storeu_si512(r + i, _mm512_mask_sub_epi64(sum, static_cast<__mmask8>(mask), sum, ones));
+    }
+
+    return _add_n_scalar(r + i, a + i, b + i, n - i, carry);
+
+}
+
+__attribute__((target("avx512f")))
+_limb _sub_n_avx512(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    const __m512i ones = _mm512_set1_epi64(-1);
+    const __m512i zero = _mm512_setzero_si512();
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vb = _mm512_loadu_si512(b + i);
+        __m512i diff = _mm512_sub_epi64(va, vb);
+        unsigned mask = _lane_carries(_mm512_cmplt_epu64_mask(va, vb), _mm512_cmpeq_epi64_mask(diff, zero), 8, &borrow);
+        _mm512_storeu_si512(r + i, _mm512_mask_add_epi64(diff, static_cast<__mmask8>(mask), diff, ones));
+    }
+
+    return _sub_n_scalar(r + i, a + i, b + i, n - i, borrow);
+
+}
+
+#else
+
+// 32 bit digits -------------------------------
+
+/**
+ * @brief Finish a block of r[i] = a[i] * m (+ r[i]) given the 64 bit products of the even
+ *        and odd digits, propagating \p carry through it.
+ *
+ */
+inline _limb _carry_products(_limb* r, const std::uint64_t* even, const std::uint64_t* odd, std::size_t pairs, _limb carry) {
+
+    for (std::size_t k = 0; k != pairs; ++k) {
+        std::uint64_t acc = even[k] + carry; // a * m + r + carry < BASE^2
+        r[2 * k] = static_cast<_limb>(acc);
+        acc = odd[k] + (acc >> 32);
+        r[2 * k + 1] = static_cast<_limb>(acc);
+        carry = static_cast<_limb>(acc >> 32);
+    }
+
+    return carry;
+
+}
+
+__attribute__((target("sse2")))
+_limb _add_n_sse2(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(1u << 31));
+    const __m128i ones = _mm_set1_epi32(-1);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i sum = _mm_add_epi32(va, vb);
+        __m128i gen = _mm_cmpgt_epi32(_mm_xor_si128(va, sign), _mm_xor_si128(sum, sign)); // sum < a
+        __m128i prop = _mm_cmpeq_epi32(sum, ones);
+        unsigned mask = _lane_carries(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(gen))),
+                                      static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(prop))), 4, &carry);
+        __m128i add = _mm_set_epi32(static_cast<int>(mask >> 3), static_cast<int>((mask >> 2) & 1),
+                                    static_cast<int>((mask >> 1) & 1), static_cast<int>(mask & 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_add_epi32(sum, add));
+    }
+
+    return _add_n_scalar(r + i, a + i, b + i, n - i, carry);
+
+}
+
+__attribute__((target("sse2")))
+_limb _sub_n_sse2(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    const __m128i sign = _mm_set1_epi32(static_cast<int>(1u << 31));
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        __m128i diff = _mm_sub_epi32(va, vb);
+        __m128i gen = _mm_cmpgt_epi32(_mm_xor_si128(vb, sign), _mm_xor_si128(va, sign)); // a < b
+        __m128i prop = _mm_cmpeq_epi32(diff, zero);
+        unsigned mask = _lane_carries(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(gen))),
+                                      static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(prop))), 4, &borrow);
+        __m128i sub = _mm_set_epi32(static_cast<int>(mask >> 3), static_cast<int>((mask >> 2) & 1),
+                                    static_cast<int>((mask >> 1) & 1), static_cast<int>(mask & 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(r + i), _mm_sub_epi32(diff, sub));
+    }
+
+    return _sub_n_scalar(r + i, a + i, b + i, n - i, borrow);
+
+}
+
+/**
+ * @brief r = a * m (+ r when \p acc) four digits at a time.
+ *
+ */
+template<bool acc>
+__attribute__((target("sse2")))
+_limb _muladd_1_sse2(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    const __m128i vm = _mm_set1_epi32(static_cast<int>(m));
+    const __m128i low = _mm_set1_epi64x(0xFFFFFFFF);
+
+    alignas(16) std::uint64_t even[2];
+    alignas(16) std::uint64_t odd[2];
+
+    _limb carry = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i pe = _mm_mul_epu32(va, vm);
+        __m128i po = _mm_mul_epu32(_mm_srli_epi64(va, 32), vm);
+        if (acc) {
+            __m128i vr = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i));
+            pe = _mm_add_epi64(pe, _mm_and_si128(vr, low));
+            po = _mm_add_epi64(po, _mm_srli_epi64(vr, 32));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(even), pe);
+        _mm_store_si128(reinterpret_cast<__m128i*>(odd), po);
+        carry = _carry_products(r + i, even, odd, 2, carry);
+    }
+
+    for (; i != n; ++i) {
+        std::uint64_t res = static_cast<std::uint64_t>(a[i]) * m + (acc ? r[i] : 0) + carry;
+        carry = static_cast<_limb>(res >> 32);
+        r[i] = static_cast<_limb>(res);
+    }
+
+    return carry;
+
+}
+
+__attribute__((target("avx2")))
+_limb _add_n_avx2(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    const __m256i sign = _mm256_set1_epi32(static_cast<int>(1u << 31));
+    const __m256i ones = _mm256_set1_epi32(-1);
+    const __m256i shifts = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i sum = _mm256_add_epi32(va, vb);
+        __m256i gen = _mm256_cmpgt_epi32(_mm256_xor_si256(va, sign), _mm256_xor_si256(sum, sign)); // sum < a
+        __m256i prop = _mm256_cmpeq_epi32(sum, ones);
+        unsigned mask = _lane_carries(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(gen))),
+                                      static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(prop))), 8, &carry);
+        __m256i add = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(mask)), shifts), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_add_epi32(sum, add));
+    }
+
+    return _add_n_scalar(r + i, a + i, b + i, n - i, carry);
+
+}
+
+__attribute__((target("avx2")))
+_limb _sub_n_avx2(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    const __m256i sign = _mm256_set1_epi32(static_cast<int>(1u << 31));
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i shifts = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i diff = _mm256_sub_epi32(va, vb);
+        __m256i gen = _mm256_cmpgt_epi32(_mm256_xor_si256(vb, sign), _mm256_xor_si256(va, sign)); // a < b
+        __m256i prop = _mm256_cmpeq_epi32(diff, zero);
+        unsigned mask = _lane_carries(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(gen))),
+                                      static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(prop))), 8, &borrow);
+        __m256i sub = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(mask)), shifts), one);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + i), _mm256_sub_epi32(diff, sub));
+    }
+
+    return _sub_n_scalar(r + i, a + i, b + i, n - i, borrow);
+
+}
+
+template<bool acc>
+__attribute__((target("avx2")))
+_limb _muladd_1_avx2(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    const __m256i vm = _mm256_set1_epi32(static_cast<int>(m));
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+
+    alignas(32) std::uint64_t even[4];
+    alignas(32) std::uint64_t odd[4];
+
+    _limb carry = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i pe = _mm256_mul_epu32(va, vm);
+        __m256i po = _mm256_mul_epu32(_mm256_srli_epi64(va, 32), vm);
+        if (acc) {
+            __m256i vr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i));
+            pe = _mm256_add_epi64(pe, _mm256_and_si256(vr, low));
+            po = _mm256_add_epi64(po, _mm256_srli_epi64(vr, 32));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(even), pe);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(odd), po);
+        carry = _carry_products(r + i, even, odd, 4, carry);
+    }
+
+    for (; i != n; ++i) {
+        std::uint64_t res = static_cast<std::uint64_t>(a[i]) * m + (acc ? r[i] : 0) + carry;
+        carry = static_cast<_limb>(res >> 32);
+        r[i] = static_cast<_limb>(res);
+    }
+
+    return carry;
+
+}
+
+__attribute__((target("avx512f")))
+_limb _add_n_avx512(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb carry) {
+
+    const __m512i ones = _mm512_set1_epi32(-1);
+
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i sum = _mm512_add_epi32(va, _mm512_loadu_si512(b + i));
+        unsigned mask = _lane_carries(_mm512_cmplt_epu32_mask(sum, va), _mm512_cmpeq_epi32_mask(sum, ones), 16, &carry);
+        _mm512_storeu_si512(r + i, _mm512_mask_sub_epi32(sum, static_cast<__mmask16>(mask), sum, ones));
+    }
+
+    return _add_n_scalar(r + i, a + i, b + i, n - i, carry);
+
+}
+
+__attribute__((target("avx512f")))
+_limb _sub_n_avx512(_limb* r, const _limb* a, const _limb* b, std::size_t n, _limb borrow) {
+
+    const __m512i ones = _mm512_set1_epi32(-1);
+    const __m512i zero = _mm512_setzero_si512();
+
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vb = _mm512_loadu_si512(b + i);
+        __m512i diff = _mm512_sub_epi32(va, vb);
+        unsigned mask = _lane_carries(_mm512_cmplt_epu32_mask(va, vb), _mm512_cmpeq_epi32_mask(diff, zero), 16, &borrow);
+        _mm512_storeu_si512(r + i, _mm512_mask_add_epi32(diff, static_cast<__mmask16>(mask), diff, ones));
+    }
+
+    return _sub_n_scalar(r + i, a + i, b + i, n - i, borrow);
+
+}
+
+template<bool acc>
+__attribute__((target("avx512f")))
+_limb _muladd_1_avx512(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    const __m512i vm = _mm512_set1_epi32(static_cast<int>(m));
+    const __m512i low = _mm512_set1_epi64(0xFFFFFFFF);
+
+    alignas(64) std::uint64_t even[8];
+    alignas(64) std::uint64_t odd[8];
+
+    _limb carry = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i pe = _mm512_mul_epu32(va, vm);
+        __m512i po = _mm512_mul_epu32(_mm512_srli_epi64(va, 32), vm);
+        if (acc) {
+            __m512i vr = _mm512_loadu_si512(r + i);
+            pe = _mm512_add_epi64(pe, _mm512_and_si512(vr, low));
+            po = _mm512_add_epi64(po, _mm512_srli_epi64(vr, 32));
+        }
+        _mm512_store_si512(even, pe);
+        _mm512_store_si512(odd, po);
+        carry = _carry_products(r + i, even, odd, 8, carry);
+    }
+
+    for (; i != n; ++i) {
+        std::uint64_t res = static_cast<std::uint64_t>(a[i]) * m + (acc ? r[i] : 0) + carry;
+        carry = static_cast<_limb>(res >> 32);
+        r[i] = static_cast<_limb>(res);
+    }
+
+    return carry;
+
+}
+
+#endif
+
+#endif
+
+// dispatch ------------------------------------
+
+/**
+ * @brief One variant of every dispatched kernel.
+ *
+ */
+struct _limb_kernels {
+    const char* name;
+    _limb (*add_n)(_limb*, const _limb*, const _limb*, std::size_t, _limb);
+    _limb (*sub_n)(_limb*, const _limb*, const _limb*, std::size_t, _limb);
+    _limb (*addmul_1)(_limb*, const _limb*, std::size_t, _limb);
+    _limb (*mul_1)(_limb*, const _limb*, std::size_t, _limb);
+};
+
+/**
+ * @brief Kernel variants this cpu can run, from the most portable to the fastest.
+ *
+ * <p> Which variant is fastest was decided with bench_bigint. </p>
+ *
+ */
+std::vector<_limb_kernels> _kernels_supported() {
+
+    std::vector<_limb_kernels> res{ { "scalar", _add_n_scalar, _sub_n_scalar, _addmul_1_scalar, _mul_1_scalar } };
+
+#ifdef BIGINT_X86_DISPATCH
+
+    __builtin_cpu_init(); // may be called before constructors of the runtime
+
+#if BIGINT_LIMB_BITS == 64
+
+    // the compiler already turns the scalar multiplications into mul and adc chains,
+    //     mulx is not faster so the vector variants keep them
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        res.push_back({ "adx", _add_n_adx, _sub_n_adx, _addmul_1_mulx, _mul_1_mulx });
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        res.push_back({ "avx2", _add_n_avx2, _sub_n_avx2, _addmul_1_scalar, _mul_1_scalar });
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        res.push_back({ "avx512", _add_n_avx512, _sub_n_avx512, _addmul_1_scalar, _mul_1_scalar });
+    }
+
+#else
+
+    if (__builtin_cpu_supports("sse2")) {
+        res.push_back({ "sse2", _add_n_sse2, _sub_n_sse2, _muladd_1_sse2<true>, _muladd_1_sse2<false> });
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        res.push_back({ "avx2", _add_n_avx2, _sub_n_avx2, _muladd_1_avx2<true>, _muladd_1_avx2<false> });
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        res.push_back({ "avx512", _add_n_avx512, _sub_n_avx512, _muladd_1_avx512<true>, _muladd_1_avx512<false> });
+    }
+
+#endif
+
+#endif
+
+    return res;
+
+}
+
+/**
+ * @brief Kernels used by BigUnsigned, chosen once at startup.
+ *
+ * <p> Not constant so another supported variant can be chosen, see bench_bigint. </p>
+ *
+ */
+_limb_kernels _kernels = _kernels_supported().back();
+
+// division by a digit -------------------------
+// each quotient digit depends on the previous remainder so there is nothing to vectorize,
+//     instead the hardware division is replaced by a multiplication with a reciprocal
+
+/**
+ * @brief Reciprocal of a normalized (top bit set) digit d, (BASE^2 - 1) / d - BASE.
+ *
+ */
+inline _limb _limb_reciprocal(_limb d) {
+
+    return static_cast<_limb>(((static_cast<_dlimb>(~d) << BASE_BIN_LENGTH) | BASE_MASK) / d);
+
+}
+
+/**
+ * @brief Divide u1 * BASE + u0 by normalized \p d with reciprocal \p v. Requires u1 < d.
+ *        Moller and Granlund, Improved division by invariant integers.
+ *
+ * @return _limb quotient, \p rem set to remainder
+ */
+inline _limb _div_preinv(_limb u1, _limb u0, _limb d, _limb v, _limb* rem) {
+
+    _dlimb q = static_cast<_dlimb>(v) * u1 + ((static_cast<_dlimb>(u1) << BASE_BIN_LENGTH) | u0);
+    _limb q1 = static_cast<_limb>(q >> BASE_BIN_LENGTH) + 1;
+    _limb q0 = static_cast<_limb>(q);
+
+    _limb r = u0 - q1 * d;
+    if (r > q0) {
+        --q1;
+        r += d;
+    }
+    if (r >= d) {
+        ++q1;
+        r -= d;
+    }
+
+    *rem = r;
+    return q1;
+
+}
+
+/**
+ * @brief q = a / d where d is a single non zero digit. \p q may alias \p a.
+ *
+ * @return _limb remainder
+ */
+_limb _divrem_1_preinv(_limb* q, const _limb* a, std::size_t n, _limb d) {
+
+    if (n == 0) {
+        return 0;
+    }
+
+    _ui shift = 0;
+    while ((d << shift) >> (BASE_BIN_LENGTH - 1) == 0) {
+        ++shift;
+    }
+
+    // divide a * 2^shift by d * 2^shift, same quotient and remainder * 2^shift
+    const _limb dn = d << shift;
+    const _limb v = _limb_reciprocal(dn);
+    const auto high = [shift](_limb x) { return shift == 0 ? 0 : x >> (BASE_BIN_LENGTH - shift); };
+
+    _limb rem = high(a[n - 1]);
+    while (n-- != 0) {
+        _limb u0 = (a[n] << shift) | (n == 0 ? 0 : high(a[n - 1]));
+        q[n] = _div_preinv(rem, u0, dn, v, &rem);
+    }
+
+    return rem >> shift;
+
+}
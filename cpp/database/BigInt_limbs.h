@@ -0,0 +1,705 @@
+// Author: Dennis Yakovlev
+
+// File containing low level routines operating on raw digit (limb) arrays.
+// Unlike BigUnsigned::digits, arrays here are stored least significant digit first
+//     and are passed as pointer and length. Lengths may include leading 0's
+//     unless stated otherwise.
+
+#pragma once
+#include <algorithm>
+#include <BigInt_alloc.h>
+#include <BigInt_kernels.h>
+#include <BigInt_ntt.h>
+#include <BigInt_thread.h>
+#include <BigInt_vars.h>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Container of least significant first digits used for temporaries.
+ *        Small ones stay inline, larger ones come from the thread's \p bigint_resource.
+ *
+ */
+using _limb_vec = _limb_storage;
+
+/**
+ * @brief Length of \p a without leading 0's.
+ *
+ */
+inline std::size_t _limbs_norm(const _limb* a, std::size_t n) {
+
+    while (n != 0 && a[n - 1] == 0) {
+        --n;
+    }
+
+    return n;
+
+}
+
+/**
+ * @brief Number of bits needed to represent \p x, 0 for 0.
+ *
+ */
+inline _ui _limb_bit_length(_limb x) {
+
+#if defined(__GNUC__)
+    return x == 0 ? 0 : static_cast<_ui>(std::numeric_limits<unsigned long long>::digits - __builtin_clzll(x));
+#else
+    _ui res = 0;
+    for (; x != 0; x >>= 1) {
+        ++res;
+    }
+
+    return res;
+#endif
+
+}
+
+/**
+ * @brief Number of trailing 0 bits of \p x, requires x != 0.
+ *
+ */
+inline _ui _limb_ctz(_limb x) {
+
+#if defined(__GNUC__)
+    return static_cast<_ui>(__builtin_ctzll(x));
+#else
+    _ui res = 0;
+    for (; (x & 1) == 0; x >>= 1) {
+        ++res;
+    }
+
+    return res;
+#endif
+
+}
+
+/**
+ * @brief r = a << shift where 0 <= shift < BASE_BIN_LENGTH. \p r may overlap \p a when r >= a.
+ *
+ * @return _limb bits shifted out of the top digit
+ */
+_limb _limbs_lshift(_limb* r, const _limb* a, std::size_t n, _ui shift) {
+
+    if (shift == 0) {
+        std::copy_backward(a, a + n, r + n);
+        return 0;
+    }
+
+    const _limb out = a[n - 1] >> (BASE_BIN_LENGTH - shift);
+    for (std::size_t i = n - 1; i != 0; --i) {
+        r[i] = (a[i] << shift) | (a[i - 1] >> (BASE_BIN_LENGTH - shift));
+    }
+    r[0] = a[0] << shift;
+
+    return out;
+
+}
+
+/**
+ * @brief r = a >> shift where 0 <= shift < BASE_BIN_LENGTH. \p r may overlap \p a when r <= a.
+ *
+ * @return _limb bits shifted out of the bottom digit, in the top bits
+ */
+_limb _limbs_rshift(_limb* r, const _limb* a, std::size_t n, _ui shift) {
+
+    if (shift == 0) {
+        std::copy(a, a + n, r);
+        return 0;
+    }
+
+    const _limb out = a[0] << (BASE_BIN_LENGTH - shift);
+    for (std::size_t i = 0; i != n - 1; ++i) {
+        r[i] = (a[i] >> shift) | (a[i + 1] << (BASE_BIN_LENGTH - shift));
+    }
+    r[n - 1] = a[n - 1] >> shift;
+
+    return out;
+
+}
+
+/**
+ * @brief Compare two normalized arrays.
+ *
+ * @return int -1, 0, 1 if a is less, equal, greater than b
+ */
+int _limbs_cmp(const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    if (an != bn) {
+        return an < bn ? -1 : 1;
+    }
+
+    while (an-- != 0) {
+        if (a[an] != b[an]) {
+            return a[an] < b[an] ? -1 : 1;
+        }
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief r = a + b. Requires an >= bn. \p r has room for an digits and may alias \p a.
+ *
+ * @return _limb carry out of the top digit
+ */
+_limb _limbs_add(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    _limb carry = _kernels.add_n(r, a, b, bn, 0);
+
+    std::size_t i = bn;
+    for (; i != an && carry != 0; ++i) {
+        r[i] = a[i] + carry;
+        carry = r[i] < carry;
+    }
+
+    if (r != a) {
+        std::copy(a + i, a + an, r + i);
+    }
+
+    return carry;
+
+}
+
+/**
+ * @brief r = a - b. Requires an >= bn. \p r has room for an digits and may alias \p a.
+ *
+ * @return _limb 1 if b > a (result wrapped) otherwise 0
+ */
+_limb _limbs_sub(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    _limb borrow = _kernels.sub_n(r, a, b, bn, 0);
+
+    std::size_t i = bn;
+    for (; i != an && borrow != 0; ++i) {
+        borrow = a[i] == 0;
+        r[i] = a[i] - 1;
+    }
+
+    if (r != a) {
+        std::copy(a + i, a + an, r + i);
+    }
+
+    return borrow;
+
+}
+
+/**
+ * @brief r[0, n) += a[0, n) * m
+ *
+ * @return _limb digit carried out past r[n - 1]
+ */
+inline _limb _limbs_addmul_1(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    return _kernels.addmul_1(r, a, n, m);
+
+}
+
+/**
+ * @brief r[0, n) = a[0, n) * m. \p r may alias \p a.
+ *
+ * @return _limb digit carried out past r[n - 1]
+ */
+inline _limb _limbs_mul_1(_limb* r, const _limb* a, std::size_t n, _limb m) {
+
+    return _kernels.mul_1(r, a, n, m);
+
+}
+
+/**
+ * @brief q = a / d where d is a single non zero digit. \p q may alias \p a.
+ *
+ * @return _limb remainder
+ */
+_limb _limbs_divrem_1(_limb* q, const _limb* a, std::size_t n, _limb d) {
+
+    if (n > 2) {
+        return _divrem_1_preinv(q, a, n, d); // reciprocal costs about one division
+    }
+
+    _limb rem = 0;
+    while (n-- != 0) {
+        _dlimb cur = (static_cast<_dlimb>(rem) << BASE_BIN_LENGTH) | a[n];
+        q[n] = static_cast<_limb>(cur / d);
+        rem = static_cast<_limb>(cur - (static_cast<_dlimb>(q[n]) * d));
+    }
+
+    return rem;
+
+}
+
+void _limbs_mul(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn);
+
+/**
+ * @brief <b> Slow </b> - theta(an * bn). r = a * b where r has room for an + bn digits.
+ *
+ */
+void _limbs_mul_basecase(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    std::fill(r, r + an + bn, 0);
+    for (std::size_t j = 0; j != bn; ++j) {
+        r[an + j] = _limbs_addmul_1(r + j, a, an, b[j]);
+    }
+
+}
+
+/**
+ * @brief <b> Slow </b> - theta(n^2 / 2). r = a * a where r has room for 2n digits.
+ *
+ * <p> Every cross product a[i] * a[j] with i < j is made once and doubled with a shift,
+ *     then the squares a[i]^2 are added. About half the digit multiplies of
+ *     \p _limbs_mul_basecase. Requires n >= 1.
+ * </p>
+ *
+ */
+void _limbs_sqr_basecase(_limb* r, const _limb* a, std::size_t n) {
+
+    std::fill(r, r + 2 * n, 0);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        r[n + i] = _limbs_addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+    r[2 * n - 1] = _limbs_lshift(r, r, 2 * n - 1, 1);
+
+    _limb carry = 0;
+    for (std::size_t i = 0; i != n; ++i) {
+        const _dlimb sq = static_cast<_dlimb>(a[i]) * a[i];
+        const _dlimb lo = static_cast<_dlimb>(r[2 * i]) + static_cast<_limb>(sq) + carry;
+        r[2 * i] = static_cast<_limb>(lo);
+        const _dlimb hi = static_cast<_dlimb>(r[2 * i + 1]) + static_cast<_limb>(sq >> BASE_BIN_LENGTH) + static_cast<_limb>(lo >> BASE_BIN_LENGTH);
+        r[2 * i + 1] = static_cast<_limb>(hi);
+        carry = static_cast<_limb>(hi >> BASE_BIN_LENGTH);
+    }
+
+}
+
+void _limbs_sqr(_limb* r, const _limb* a, std::size_t n);
+
+/**
+ * @brief theta(n^1.585). r = a * a where r has room for 2n digits.
+ *
+ * <p> Three half size squares, the middle term is a0^2 + a1^2 - (a0 - a1)^2 which
+ *     needs no extra digit unlike (a0 + a1)^2. Requires n >= 2.
+ * </p>
+ *
+ */
+void _limbs_sqr_karatsuba(_limb* r, const _limb* a, std::size_t n) {
+
+    const std::size_t h = (n + 1) / 2; // a = a1 * BASE^h + a0
+
+    const _limb* a0 = a;
+    const _limb* a1 = a + h;
+    const std::size_t a1n = n - h;
+
+    _limb_vec t(2 * h); // sized here, an arena of this thread must not grow on another
+    std::function<void()> squares[3] = {
+        [&]() { _limbs_sqr(r, a0, h); }, // z0 in r[0, 2h)
+        [&]() { _limbs_sqr(r + 2 * h, a1, a1n); }, // z2 in r[2h, 2n)
+        [&]() {
+            const auto a0n = _limbs_norm(a0, h);
+            const auto a1nn = _limbs_norm(a1, a1n);
+            _limb_vec d(h); // |a0 - a1|
+            if (_limbs_cmp(a0, a0n, a1, a1nn) >= 0) {
+                _limbs_sub(d.data(), a0, a0n, a1, a1nn);
+            } else {
+                _limbs_sub(d.data(), a1, a1nn, a0, a0n);
+            }
+
+            const auto dn = _limbs_norm(d.data(), h);
+            if (dn != 0) {
+                _limbs_sqr(t.data(), d.data(), dn);
+            }
+        }
+    };
+
+    if (n >= parallel_mul_threshold) {
+        _parallel_invoke(squares, 3);
+    } else {
+        for (auto& square : squares) {
+            square();
+        }
+    }
+
+    // m = z0 + z2 - (a0 - a1)^2 = 2 * a0 * a1
+    _limb_vec m(r, r + 2 * h);
+    m.push_back(_limbs_add(m.data(), m.data(), 2 * h, r + 2 * h, 2 * a1n));
+    _limbs_sub(m.data(), m.data(), m.size(), t.data(), t.size());
+
+    _limbs_add(r + h, r + h, 2 * n - h, m.data(), _limbs_norm(m.data(), m.size()));
+
+}
+
+/**
+ * @brief theta(n^1.585). r = a * b where r has room for an + bn digits.
+ *
+ * <p> Requires an >= bn > (an + 1) / 2 </p>
+ *
+ */
+void _limbs_mul_karatsuba(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    const std::size_t h = (an + 1) / 2; // a = a1 * BASE^h + a0, likewise b
+
+    const _limb* a0 = a;
+    const _limb* a1 = a + h;
+    const _limb* b0 = b;
+    const _limb* b1 = b + h;
+    const std::size_t a1n = an - h;
+    const std::size_t b1n = bn - h;
+
+    _limb_vec t(2 * (h + 1)); // sized here, an arena of this thread must not grow on another
+    std::function<void()> products[3] = {
+        [&]() { _limbs_mul(r, a0, h, b0, h); }, // z0 in r[0, 2h)
+        [&]() { _limbs_mul(r + 2 * h, a1, a1n, b1, b1n); }, // z2 in r[2h, an + bn)
+        [&]() {
+            _limb_vec sa(h + 1); // a0 + a1
+            _limb_vec sb(h + 1); // b0 + b1
+            sa[h] = _limbs_add(sa.data(), a0, h, a1, a1n);
+            sb[h] = _limbs_add(sb.data(), b0, h, b1, b1n);
+
+            const auto san = _limbs_norm(sa.data(), h + 1);
+            const auto sbn = _limbs_norm(sb.data(), h + 1);
+            if (san != 0 && sbn != 0) {
+                _limbs_mul(t.data(), sa.data(), san, sb.data(), sbn);
+            }
+        }
+    };
+
+    if (bn >= parallel_mul_threshold) {
+        _parallel_invoke(products, 3);
+    } else {
+        for (auto& product : products) {
+            product();
+        }
+    }
+
+    // t = (a0 + a1) * (b0 + b1) - z0 - z2 = a0 * b1 + a1 * b0
+    _limbs_sub(t.data(), t.data(), t.size(), r, _limbs_norm(r, 2 * h));
+    _limbs_sub(t.data(), t.data(), t.size(), r + 2 * h, _limbs_norm(r + 2 * h, a1n + b1n));
+
+    _limbs_add(r + h, r + h, an + bn - h, t.data(), _limbs_norm(t.data(), t.size()));
+
+}
+
+/**
+ * @brief Signed value used for the intermediate values of \p _limbs_mul_toom3.
+ *
+ */
+struct _toom_val {
+    _limb_vec mag; // normalized magnitude
+    bool neg = false;
+};
+
+/**
+ * @brief l + r, or l - r if \p sub
+ *
+ */
+_toom_val _toom_add(const _toom_val& l, const _toom_val& r, bool sub) {
+
+    const bool r_neg = r.neg != sub;
+    const _toom_val* longer = l.mag.size() >= r.mag.size() ? &l : &r;
+    const _toom_val* shorter = longer == &l ? &r : &l;
+
+    _toom_val res;
+    if (l.neg == r_neg) {
+        res.mag.resize(longer->mag.size() + 1);
+        res.mag.back() = _limbs_add(res.mag.data(), longer->mag.data(), longer->mag.size(), shorter->mag.data(), shorter->mag.size());
+        res.neg = l.neg;
+    } else {
+        int cmp = _limbs_cmp(l.mag.data(), l.mag.size(), r.mag.data(), r.mag.size());
+        if (cmp == 0) {
+            return res;
+        }
+        longer = cmp > 0 ? &l : &r;
+        shorter = cmp > 0 ? &r : &l;
+        res.mag.resize(longer->mag.size());
+        _limbs_sub(res.mag.data(), longer->mag.data(), longer->mag.size(), shorter->mag.data(), shorter->mag.size());
+        res.neg = cmp > 0 ? l.neg : r_neg;
+    }
+
+    res.mag.resize(_limbs_norm(res.mag.data(), res.mag.size()));
+    res.neg = res.neg && !res.mag.empty();
+
+    return res;
+
+}
+
+_toom_val _toom_mul(const _toom_val& l, const _toom_val& r) {
+
+    _toom_val res;
+    if (l.mag.empty() || r.mag.empty()) {
+        return res;
+    }
+
+    res.mag.resize(l.mag.size() + r.mag.size());
+    _limbs_mul(res.mag.data(), l.mag.data(), l.mag.size(), r.mag.data(), r.mag.size());
+    res.mag.resize(_limbs_norm(res.mag.data(), res.mag.size()));
+    res.neg = l.neg != r.neg;
+
+    return res;
+
+}
+
+/**
+ * @brief Exact division by a single digit.
+ *
+ */
+_toom_val _toom_div(_toom_val v, _limb d) {
+
+    _limbs_divrem_1(v.mag.data(), v.mag.data(), v.mag.size(), d);
+    v.mag.resize(_limbs_norm(v.mag.data(), v.mag.size()));
+    v.neg = v.neg && !v.mag.empty();
+
+    return v;
+
+}
+
+/**
+ * @brief Multiply by a single digit.
+ *
+ */
+_toom_val _toom_mul_1(const _toom_val& v, _limb m) {
+
+    _toom_val res;
+    res.mag.assign(v.mag.size() + 1, 0);
+    res.mag.back() = _limbs_addmul_1(res.mag.data(), v.mag.data(), v.mag.size(), m);
+    res.mag.resize(_limbs_norm(res.mag.data(), res.mag.size()));
+    res.neg = v.neg && !res.mag.empty();
+
+    return res;
+
+}
+
+/**
+ * @brief theta(n^1.465). r = a * b where r has room for an + bn digits.
+ *
+ * <p> Evaluates at 0, 1, -1, -2, inf and interpolates with Bodrato's sequence. <br>
+ *     The five products run in parallel above \p parallel_mul_threshold.
+ * </p>
+ * <p> Requires an >= bn > 2 * ((an + 2) / 3) </p>
+ *
+ */
+void _limbs_mul_toom3(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    const std::size_t k = (an + 2) / 3; // a = a2 * BASE^2k + a1 * BASE^k + a0, likewise b
+
+    auto piece = [](const _limb* start, std::size_t len) {
+        _toom_val v;
+        v.mag.assign(start, start + _limbs_norm(start, len));
+        return v;
+    };
+
+    // p(x) = a2 * x^2 + a1 * x + a0 evaluated at points
+    auto evaluate = [&piece, k](const _limb* x, std::size_t xn, _toom_val* at) {
+        _toom_val x0 = piece(x, k);
+        _toom_val x1 = piece(x + k, k);
+        _toom_val x2 = piece(x + 2 * k, xn - 2 * k);
+
+        _toom_val tmp = _toom_add(x0, x2, false);
+        at[2] = _toom_add(tmp, x1, true); // p(-1)
+        at[1] = _toom_add(tmp, x1, false); // p(1)
+        tmp = _toom_add(at[2], x2, false);
+        at[3] = _toom_add(_toom_mul_1(tmp, 2), x0, true); // p(-2)
+        at[0] = std::move(x0); // p(0)
+        at[4] = std::move(x2); // p(inf)
+    };
+
+    const bool square = a == b && an == bn;
+
+    _toom_val pa[5];
+    _toom_val pb[5];
+    evaluate(a, an, pa);
+    if (!square) {
+        evaluate(b, bn, pb);
+    }
+
+    auto* heap = bigint_heap_resource(); // filled on other threads, so not from an arena of this one
+    _toom_val prods[5] = { {_limb_vec(heap)}, {_limb_vec(heap)}, {_limb_vec(heap)}, {_limb_vec(heap)}, {_limb_vec(heap)} };
+    std::function<void()> products[5];
+    for (std::size_t i = 0; i != 5; ++i) {
+        products[i] = [&, i]() { prods[i] = _toom_mul(pa[i], square ? pa[i] : pb[i]); };
+    }
+
+    if (bn >= parallel_mul_threshold) {
+        _parallel_invoke(products, 5);
+    } else {
+        for (auto& product : products) {
+            product();
+        }
+    }
+
+    _toom_val r0 = std::move(prods[0]);
+    _toom_val r1 = std::move(prods[1]);
+    _toom_val rm1 = std::move(prods[2]);
+    _toom_val rm2 = std::move(prods[3]);
+    _toom_val rinf = std::move(prods[4]);
+
+    _toom_val r3 = _toom_div(_toom_add(rm2, r1, true), 3);
+    r1 = _toom_div(_toom_add(r1, rm1, true), 2);
+    _toom_val r2 = _toom_add(rm1, r0, true);
+    r3 = _toom_add(_toom_div(_toom_add(r2, r3, true), 2), _toom_mul_1(rinf, 2), false);
+    r2 = _toom_add(_toom_add(r2, r1, false), rinf, true);
+    r1 = _toom_add(r1, r3, true);
+
+    const std::size_t rn = an + bn;
+    std::fill(r, r + rn, 0);
+    const _toom_val* coeffs[5] = {&r0, &r1, &r2, &r3, &rinf};
+    for (std::size_t i = 0; i != 5; ++i) {
+        const auto& mag = coeffs[i]->mag;
+        if (!mag.empty()) {
+            _limbs_add(r + i * k, r + i * k, rn - i * k, mag.data(), mag.size());
+        }
+    }
+
+}
+
+/**
+ * @brief r = a * b where r has room for an + bn digits and does not overlap a or b.
+ *
+ * <p> Picks schoolbook, Karatsuba, Toom-3 or the number theoretic transform depending on
+ *     \p karatsuba_threshold, \p toom3_threshold and \p ntt_threshold. Operands of very
+ *     different lengths are split into pieces the size of the shorter one.
+ * </p>
+ *
+ */
+void _limbs_mul(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    if (an < bn) {
+        std::swap(a, b);
+        std::swap(an, bn);
+    }
+
+    if (bn == 0) {
+        std::fill(r, r + an, 0);
+        return;
+    }
+
+    if (a == b && an == bn) {
+        _limbs_sqr(r, a, an);
+        return;
+    }
+
+    if (bn < karatsuba_threshold) {
+        _limbs_mul_basecase(r, a, an, b, bn);
+        return;
+    }
+
+    if (bn <= (an + 1) / 2) { // too unbalanced to split both the same way
+        std::fill(r, r + an + bn, 0);
+        _limb_vec tmp(2 * bn);
+        for (std::size_t off = 0; off < an; off += bn) {
+            const std::size_t len = std::min(bn, an - off);
+            _limbs_mul(tmp.data(), b, bn, a + off, len);
+            _limbs_add(r + off, r + off, an + bn - off, tmp.data(), len + bn);
+        }
+        return;
+    }
+
+    if (bn >= ntt_threshold && _ntt_fits(an, bn)) {
+        _limbs_mul_ntt(r, a, an, b, bn);
+        return;
+    }
+
+    if (bn >= toom3_threshold && bn > 2 * ((an + 2) / 3)) {
+        _limbs_mul_toom3(r, a, an, b, bn);
+        return;
+    }
+
+    _limbs_mul_karatsuba(r, a, an, b, bn);
+
+}
+
+/**
+ * @brief r = a * a where r has room for 2n digits and does not overlap a.
+ *
+ * <p> Like \p _limbs_mul but squares with \p karatsuba_sqr_threshold in place of
+ *     \p karatsuba_threshold. Toom-3 and the number theoretic transform evaluate or
+ *     transform the number once.
+ * </p>
+ *
+ */
+void _limbs_sqr(_limb* r, const _limb* a, std::size_t n) {
+
+    if (n < karatsuba_sqr_threshold) {
+        _limbs_sqr_basecase(r, a, n);
+        return;
+    }
+
+    if (n >= ntt_threshold && _ntt_fits(n, n)) {
+        _limbs_mul_ntt(r, a, n, a, n);
+        return;
+    }
+
+    if (n >= toom3_threshold) {
+        _limbs_mul_toom3(r, a, n, a, n);
+        return;
+    }
+
+    _limbs_sqr_karatsuba(r, a, n);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(vn * (un - vn + 1)). Knuth algorithm D (normalized schoolbook long division).
+ *        q = u / v and r = u % v.
+ *
+ * <p> Requires un >= vn >= 2 and v[vn - 1] != 0. \p q has room for un - vn + 1 digits and
+ *     \p r has room for vn digits. Neither may overlap \p u or \p v.
+ * </p>
+ *
+ */
+void _limbs_divrem(_limb* q, _limb* r, const _limb* u, std::size_t un, const _limb* v, std::size_t vn) {
+
+    // normalize so the top bit of the divisor is set, keeps qhat off by at most 2
+    const _ui shift = BASE_BIN_LENGTH - _limb_bit_length(v[vn - 1]);
+
+    _limb_vec vs(vn);
+    _limb_vec us(un + 1);
+    _limbs_lshift(vs.data(), v, vn, shift);
+    us[un] = _limbs_lshift(us.data(), u, un, shift);
+
+    const _limb v_top = vs[vn - 1];
+    const _limb v_next = vs[vn - 2];
+
+    for (std::size_t j = un - vn + 1; j-- != 0;) {
+        // estimate from the top two digits, then correct with the third
+        _dlimb num = (static_cast<_dlimb>(us[j + vn]) << BASE_BIN_LENGTH) | us[j + vn - 1];
+        _dlimb qhat = num / v_top;
+        _dlimb rhat = num - (qhat * v_top);
+        while (qhat >= BASE || qhat * v_next > ((rhat << BASE_BIN_LENGTH) | us[j + vn - 2])) {
+            --qhat;
+            rhat += v_top;
+            if (rhat >= BASE) {
+                break;
+            }
+        }
+
+        // us[j, j + vn] -= qhat * vs
+        _limb carry = 0;
+        _limb borrow = 0;
+        for (std::size_t i = 0; i != vn; ++i) {
+            _dlimb prod = qhat * vs[i] + carry;
+            carry = static_cast<_limb>(prod >> BASE_BIN_LENGTH);
+            _limb prod_low = static_cast<_limb>(prod);
+            _limb diff = us[i + j] - prod_low;
+            _limb borrow_new = us[i + j] < prod_low;
+            us[i + j] = diff - borrow;
+            borrow = borrow_new | (diff < borrow);
+        }
+        _limb top = us[j + vn];
+        us[j + vn] = top - carry - borrow;
+        borrow = (top < carry) || (top - carry < borrow);
+
+        if (borrow != 0) { // estimate was one too large, add back
+            --qhat;
+            us[j + vn] += _limbs_add(us.data() + j, us.data() + j, vn, vs.data(), vn);
+        }
+
+        q[j] = static_cast<_limb>(qhat);
+    }
+
+    // unnormalize remainder, us[vn, un] is 0 by now
+    _limbs_rshift(r, us.data(), vn, shift);
+
+}
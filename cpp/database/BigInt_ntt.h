@@ -0,0 +1,344 @@
+// Author: Dennis Yakovlev
+
+// File containing the number theoretic transform multiplication used for
+//     huge BigUnsigned numbers.
+
+#pragma once
+#include <algorithm>
+#include <BigInt_thread.h>
+#include <BigInt_vars.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Prime p = c * 2^k + 1 with primitive root g, allows transforms up to length 2^k.
+ *
+ */
+struct _ntt_prime {
+    std::uint32_t p;
+    std::uint32_t g;
+};
+
+/**
+ * @brief Primes the convolution is done modulo. Their product is about 2^89.2, above
+ *        any coefficient 2^23 * (2^32)^2 of a product of 32 bit pieces.
+ *
+ */
+constexpr _ntt_prime NTT_PRIMES[3] = {
+    {2013265921u, 31u}, // 15 * 2^27 + 1
+    {469762049u, 3u}, // 7 * 2^26 + 1
+    {754974721u, 11u} // 45 * 2^24 + 1
+};
+
+/**
+ * @brief Log of the longest transform all of \p NTT_PRIMES allow.
+ *
+ */
+constexpr _ui NTT_MAX_LOG = 24;
+
+/**
+ * @brief 32 bit pieces per digit, the transforms work on pieces.
+ *
+ */
+constexpr std::size_t NTT_PIECES = BASE_BIN_LENGTH / 32;
+
+/**
+ * @brief Montgomery arithmetic modulo a prime below 2^31, R = 2^32.
+ *
+ * <p> Values are kept in [0, p). </p>
+ *
+ */
+struct _mont32 {
+
+    explicit _mont32(std::uint32_t mod) : p(mod) {
+
+        std::uint32_t inv = mod; // Newton's iteration, correct to 2^32 after 4 steps
+        for (int i = 0; i != 4; ++i) {
+            inv *= 2u - mod * inv;
+        }
+        p_neg_inv = 0u - inv;
+
+        const std::uint64_t r = (static_cast<std::uint64_t>(1) << 32) % mod;
+        r2 = static_cast<std::uint32_t>(r * r % mod);
+
+    }
+
+    /**
+     * @brief t / R mod p, requires t < p * R
+     *
+     */
+    std::uint32_t reduce(std::uint64_t t) const {
+
+        const std::uint32_t m = static_cast<std::uint32_t>(t) * p_neg_inv;
+        const std::uint32_t u = static_cast<std::uint32_t>((t + static_cast<std::uint64_t>(m) * p) >> 32);
+        return std::min(u, u - p); // u - p wraps when u < p, branch free so loops vectorize
+
+    }
+
+    std::uint32_t mul(std::uint32_t l, std::uint32_t r) const {
+
+        return reduce(static_cast<std::uint64_t>(l) * r);
+
+    }
+
+    std::uint32_t add(std::uint32_t l, std::uint32_t r) const {
+
+        const std::uint32_t s = l + r;
+        return std::min(s, s - p);
+
+    }
+
+    std::uint32_t sub(std::uint32_t l, std::uint32_t r) const {
+
+        const std::uint32_t d = l - r;
+        return std::min(d, d + p);
+
+    }
+
+    /**
+     * @brief Montgomery form of any 32 bit value.
+     *
+     */
+    std::uint32_t to(std::uint32_t val) const {
+
+        return mul(val, r2);
+
+    }
+
+    std::uint32_t from(std::uint32_t val) const {
+
+        return reduce(val);
+
+    }
+
+    std::uint32_t pow(std::uint32_t base, std::uint64_t exp) const {
+
+        std::uint32_t res = to(1);
+        while (exp != 0) {
+            if (exp & 1) {
+                res = mul(res, base);
+            }
+            base = mul(base, base);
+            exp >>= 1;
+        }
+
+        return res;
+
+    }
+
+    std::uint32_t p;
+    std::uint32_t p_neg_inv; // -p^-1 mod R
+    std::uint32_t r2; // R^2 mod p
+
+};
+
+/**
+ * @brief tw[len + j] = w^j where w is a primitive 2 * len'th root of unity, for every
+ *        power of two len < n. In Montgomery form.
+ *
+ */
+void _ntt_twiddles(const _mont32& mont, std::uint32_t root, std::size_t n, std::vector<std::uint32_t>* tw) {
+
+    tw->assign(n, 0);
+    if (n < 2) {
+        return;
+    }
+
+    std::uint32_t cur = mont.to(1);
+    for (std::size_t j = 0; j != n / 2; ++j) {
+        (*tw)[n / 2 + j] = cur;
+        cur = mont.mul(cur, root);
+    }
+    for (std::size_t len = n / 4; len != 0; len /= 2) {
+        for (std::size_t j = 0; j != len; ++j) {
+            (*tw)[len + j] = (*tw)[2 * (len + j)];
+        }
+    }
+
+}
+
+/**
+ * @brief Decimation in frequency transform, natural order in and bit reversed order out.
+ *
+ */
+void _ntt_forward(const _mont32& mont, const std::uint32_t* tw, std::uint32_t* x, std::size_t n) {
+
+    for (std::size_t len = n / 2; len != 0; len /= 2) {
+        for (std::size_t i = 0; i != n; i += 2 * len) {
+            for (std::size_t j = 0; j != len; ++j) {
+                const std::uint32_t u = x[i + j];
+                const std::uint32_t v = x[i + j + len];
+                x[i + j] = mont.add(u, v);
+                x[i + j + len] = mont.mul(mont.sub(u, v), tw[len + j]);
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief Decimation in time transform with the inverse twiddles, bit reversed order in and
+ *        natural order out. Not scaled by 1 / n.
+ *
+ */
+void _ntt_inverse(const _mont32& mont, const std::uint32_t* tw, std::uint32_t* x, std::size_t n) {
+
+    for (std::size_t len = 1; len != n; len *= 2) {
+        for (std::size_t i = 0; i != n; i += 2 * len) {
+            for (std::size_t j = 0; j != len; ++j) {
+                const std::uint32_t u = x[i + j];
+                const std::uint32_t v = mont.mul(x[i + j + len], tw[len + j]);
+                x[i + j] = mont.add(u, v);
+                x[i + j + len] = mont.sub(u, v);
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief res[0, an + bn - 1) = cyclic convolution of the pieces a and b modulo \p prime
+ *        with transform length n, which is a power of two >= an + bn - 1.
+ *
+ * <p> Squares with one forward transform when a and b are the same. </p>
+ *
+ */
+void _ntt_convolve(const _ntt_prime& prime, const std::uint32_t* a, std::size_t an, const std::uint32_t* b, std::size_t bn,
+    std::size_t n, std::uint32_t* res) {
+
+    const _mont32 mont(prime.p);
+
+    _ui log = 0;
+    while ((static_cast<std::size_t>(1) << log) < n) {
+        ++log;
+    }
+    const std::uint32_t root = mont.pow(mont.to(prime.g), (prime.p - 1) >> log);
+
+    std::vector<std::uint32_t> tw;
+    std::vector<std::uint32_t> fa(n, 0);
+    std::vector<std::uint32_t> fb;
+
+    for (std::size_t i = 0; i != an; ++i) {
+        fa[i] = mont.to(a[i]);
+    }
+    _ntt_twiddles(mont, root, n, &tw);
+    _ntt_forward(mont, tw.data(), fa.data(), n);
+
+    const bool square = a == b && an == bn;
+    if (!square) {
+        fb.assign(n, 0);
+        for (std::size_t i = 0; i != bn; ++i) {
+            fb[i] = mont.to(b[i]);
+        }
+        _ntt_forward(mont, tw.data(), fb.data(), n);
+    }
+    const std::uint32_t* fbp = square ? fa.data() : fb.data();
+
+    const std::uint32_t n_inv = mont.pow(mont.to(static_cast<std::uint32_t>(n % prime.p)), prime.p - 2);
+    for (std::size_t i = 0; i != n; ++i) {
+        fa[i] = mont.mul(mont.mul(fa[i], fbp[i]), n_inv);
+    }
+
+    _ntt_twiddles(mont, mont.pow(root, prime.p - 2), n, &tw);
+    _ntt_inverse(mont, tw.data(), fa.data(), n);
+
+    for (std::size_t i = 0; i != an + bn - 1; ++i) {
+        res[i] = mont.from(fa[i]);
+    }
+
+}
+
+/**
+ * @brief Whether \p _limbs_mul_ntt can multiply numbers with an and bn digits.
+ *
+ */
+inline bool _ntt_fits(std::size_t an, std::size_t bn) {
+
+    return (an + bn) * NTT_PIECES <= (static_cast<std::size_t>(1) << NTT_MAX_LOG);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(n log n). r = a * b where r has room for an + bn digits.
+ *
+ * <p> Digits are split into 32 bit pieces and convolved modulo each of \p NTT_PRIMES,
+ *     in parallel when \p bigint_threads allows. Garner's algorithm recovers every
+ *     coefficient exactly from the three residues and the carries are propagated.
+ * </p>
+ * <p> Requires an, bn > 0 and \p _ntt_fits(an, bn). </p>
+ *
+ */
+void _limbs_mul_ntt(_limb* r, const _limb* a, std::size_t an, const _limb* b, std::size_t bn) {
+
+    const bool square = a == b && an == bn;
+
+    const std::size_t ap = an * NTT_PIECES;
+    const std::size_t bp = bn * NTT_PIECES;
+    const std::size_t len = ap + bp - 1;
+
+    std::size_t n = 1;
+    while (n < len) {
+        n *= 2;
+    }
+
+    std::vector<std::uint32_t> pa(ap);
+    std::vector<std::uint32_t> pb(square ? 0 : bp);
+    for (std::size_t i = 0; i != ap; ++i) {
+        pa[i] = static_cast<std::uint32_t>(a[i / NTT_PIECES] >> (32 * (i % NTT_PIECES)));
+    }
+    for (std::size_t i = 0; i != pb.size(); ++i) {
+        pb[i] = static_cast<std::uint32_t>(b[i / NTT_PIECES] >> (32 * (i % NTT_PIECES)));
+    }
+    const std::uint32_t* pbp = square ? pa.data() : pb.data();
+
+    std::vector<std::uint32_t> res[3];
+    std::function<void()> convolutions[3];
+    for (std::size_t k = 0; k != 3; ++k) {
+        res[k].resize(len);
+        convolutions[k] = [&, k]() { _ntt_convolve(NTT_PRIMES[k], pa.data(), ap, pbp, bp, n, res[k].data()); };
+    }
+    _parallel_invoke(convolutions, 3);
+
+    // Garner, coefficient = r0 + p0 * v1 + p0 * p1 * v2
+    const std::uint64_t p0 = NTT_PRIMES[0].p;
+    const std::uint64_t p1 = NTT_PRIMES[1].p;
+    const std::uint64_t p2 = NTT_PRIMES[2].p;
+    const _mont32 m1(NTT_PRIMES[1].p);
+    const _mont32 m2(NTT_PRIMES[2].p);
+    const std::uint32_t p0_inv_1 = m1.pow(m1.to(static_cast<std::uint32_t>(p0 % p1)), p1 - 2); // Montgomery form
+    const std::uint32_t p01_inv_2 = m2.pow(m2.to(static_cast<std::uint32_t>(p0 * p1 % p2)), p2 - 2);
+    const std::uint64_t p01 = p0 * p1;
+    const std::uint64_t p01_lo = p01 & 0xffffffffu;
+    const std::uint64_t p01_hi = p01 >> 32;
+    constexpr std::uint64_t mask = 0xffffffffu;
+
+    std::vector<std::uint32_t> pieces(ap + bp);
+    std::uint64_t c0 = 0; // carry into the current piece
+    std::uint64_t c1 = 0; // carry into the next piece
+
+    for (std::size_t i = 0; i != len; ++i) {
+        const std::uint32_t r0 = res[0][i];
+        const std::uint32_t v1 = m1.mul(m1.sub(res[1][i], static_cast<std::uint32_t>(r0 % p1)), p0_inv_1);
+        const std::uint64_t t = r0 + p0 * v1; // < 2^61
+        const std::uint32_t v2 = m2.mul(m2.sub(res[2][i], static_cast<std::uint32_t>(t % p2)), p01_inv_2);
+        const std::uint64_t u = p01_lo * v2; // < 2^62
+        const std::uint64_t w = p01_hi * v2; // < 2^58, weighs 2^32
+
+        const std::uint64_t acc = c0 + (t & mask) + (u & mask);
+        pieces[i] = static_cast<std::uint32_t>(acc);
+        c0 = c1 + (acc >> 32) + (t >> 32) + (u >> 32) + (w & mask);
+        c1 = w >> 32;
+    }
+    pieces[len] = static_cast<std::uint32_t>(c0); // product fits in ap + bp pieces so no carry is left
+
+    for (std::size_t i = 0; i != an + bn; ++i) {
+        _limb digit = 0;
+        for (std::size_t j = 0; j != NTT_PIECES; ++j) {
+            digit |= static_cast<_limb>(pieces[i * NTT_PIECES + j]) << (32 * j);
+        }
+        r[i] = digit;
+    }
+
+}
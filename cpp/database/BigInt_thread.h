@@ -0,0 +1,198 @@
+// Author: Dennis Yakovlev
+
+// File containing the thread pool used to multiply very large BigUnsigned
+//     numbers on several cores.
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <BigInt_alloc.h>
+#include <BigInt_vars.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads running queued tasks.
+ *
+ * <p> Threads waiting for tasks run queued ones themselves (see \p run_one), so tasks
+ *     may wait for tasks they queued without running out of workers.
+ * </p>
+ *
+ */
+class _thread_pool {
+
+public:
+
+    explicit _thread_pool(std::size_t workers) {
+
+        for (std::size_t i = 0; i != workers; ++i) {
+            _workers.emplace_back([this]() { _work(); });
+        }
+
+    }
+
+    _thread_pool(const _thread_pool&) = delete;
+    _thread_pool& operator= (const _thread_pool&) = delete;
+
+    ~_thread_pool() {
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_all();
+
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+
+    }
+
+    void submit(std::function<void()> task) {
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.emplace_back(std::move(task));
+        }
+        _cv.notify_one();
+
+    }
+
+    /**
+     * @brief Run a queued task on the calling thread.
+     *
+     * @return false if there was none
+     */
+    bool run_one() {
+
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_tasks.empty()) {
+                return false;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+
+        return true;
+
+    }
+
+    std::size_t size() const {
+
+        return _workers.size();
+
+    }
+
+private:
+
+    void _work() {
+
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+                if (_stop && _tasks.empty()) {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+
+    }
+
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stop = false;
+
+};
+
+/**
+ * @brief Threads used by a multiplication, 1 multiplies on the calling thread only.
+ *
+ * <p> Change with \p set_bigint_threads. </p>
+ *
+ */
+std::size_t bigint_threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+std::unique_ptr<_thread_pool> _pool_ptr;
+
+/**
+ * @brief Set \p bigint_threads. Must not be called while another thread is multiplying.
+ *
+ */
+void set_bigint_threads(std::size_t threads) {
+
+    bigint_threads = std::max<std::size_t>(1, threads);
+    _pool_ptr.reset();
+
+}
+
+/**
+ * @brief Pool with bigint_threads - 1 workers, the calling thread is the last one.
+ *
+ */
+_thread_pool& _pool() {
+
+    static std::mutex create;
+
+    std::lock_guard<std::mutex> lock(create);
+    if (!_pool_ptr) {
+        _pool_ptr = std::make_unique<_thread_pool>(bigint_threads - 1);
+    }
+
+    return *_pool_ptr;
+
+}
+
+/**
+ * @brief Run all of \p tasks, in parallel when \p bigint_threads allows, and return when all are done.
+ *
+ * <p> Tasks take digit storage from the heap, an arena of the calling thread
+ *     can only be used by that thread.
+ * </p>
+ *
+ */
+void _parallel_invoke(std::function<void()>* tasks, std::size_t n) {
+
+    resource_scope heap(bigint_heap_resource());
+
+    if (bigint_threads == 1 || n == 1) {
+        for (std::size_t i = 0; i != n; ++i) {
+            tasks[i]();
+        }
+        return;
+    }
+
+    auto& pool = _pool();
+    std::atomic<std::size_t> remaining(n - 1);
+    for (std::size_t i = 1; i != n; ++i) {
+        pool.submit([task = &tasks[i], &remaining]() {
+            resource_scope heap_task(bigint_heap_resource());
+            (*task)();
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    tasks[0]();
+
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        if (!pool.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+
+}
@@ -0,0 +1,223 @@
+// Author: Dennis Yakovlev
+
+// File containing members to be used by other members relating to BigUnsigned type.
+
+#pragma once
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+using _ull = unsigned long long;
+using _ui = unsigned int;
+using _ld = long double;
+
+/**
+ * @brief Number of binary digits in a digit (limb) of BigUnsigned. 32 or 64.
+ *
+ * <p> Define before including to choose. By default 64 when the compiler has
+ *     unsigned __int128 for the double width products (x86_64 gcc/clang),
+ *     otherwise 32 (x86_32, msvc).
+ * </p>
+ *
+ */
+#ifndef BIGINT_LIMB_BITS
+#if defined(__SIZEOF_INT128__)
+#define BIGINT_LIMB_BITS 64
+#else
+#define BIGINT_LIMB_BITS 32
+#endif
+#endif
+
+#if BIGINT_LIMB_BITS == 64
+
+#if !defined(__SIZEOF_INT128__)
+#error "64 bit digits need unsigned __int128"
+#endif
+
+/**
+ * @brief Type of a single digit.
+ *
+ */
+using _limb = std::uint64_t;
+
+/**
+ * @brief Type holding at least two digits, for products and carries.
+ *
+ */
+using _dlimb = unsigned __int128;
+
+#elif BIGINT_LIMB_BITS == 32
+
+using _limb = std::uint32_t;
+using _dlimb = std::uint64_t;
+
+#else
+#error "BIGINT_LIMB_BITS must be 32 or 64"
+#endif
+
+/**
+ * @brief Number of binary digits in the base.
+ *
+ */
+constexpr _ui BASE_BIN_LENGTH = static_cast<_ui>(std::numeric_limits<_limb>::digits);
+
+/**
+ * @brief Base to use to store digits.
+ * <p> Note: Must be power of 2 <br>
+ *     Note: Is one more than the max value of \p _limb so is stored as \p _dlimb <br>
+ *     Note: Digits range from [0, base)
+ * </p>
+ *
+ */
+constexpr _dlimb BASE = static_cast<_dlimb>(1) << BASE_BIN_LENGTH;
+
+/**
+ * @brief Largest digit, BASE - 1.
+ *
+ */
+constexpr _limb BASE_MASK = std::numeric_limits<_limb>::max();
+
+/**
+ * @brief number of base10 digits in base
+ *
+ */
+constexpr _ui BASE_DIGITS = static_cast<_ui>(std::numeric_limits<_limb>::digits10 + 1);
+
+/**
+ * @brief Maximum number of base10 digits allowed to be stored.
+ * <p> Store one less than allowed digits to allow initialization
+ *     without an if statement to see if number fits into digit. <br>
+ *     Ex: 9999999999 doesnt fit into base 2^32 but 999999999 does
+ * </p>
+ *
+ */
+constexpr _ui BASE_DIGITS_ALLOW = BASE_DIGITS - 1;
+
+/**
+ * @brief Statically usable log2 function.
+ *
+ */
+_ui log_const(double num) {
+    _ui res = 0;
+    while (num > 0) {
+        num /= 2.0;
+        num = std::floor(num);
+        ++res;
+    }
+    return res;
+}
+
+/**
+ * @brief Statically usable number of binary digits, 0 for 0.
+ *
+ */
+constexpr _ui bit_length_const(_ull num) {
+    _ui res = 0;
+    for (; num != 0; num >>= 1) {
+        ++res;
+    }
+    return res;
+}
+
+/**
+ * @brief If the number of digits in the container is less than or qual to this then a conversion without loss of precision can be used to double.
+ *
+ */
+static const _ui DOUBLE_CONVERSION = (log_const(DBL_MAX) / log_const(static_cast<double>(BASE))) - 1;
+
+/**
+ * @brief ty must be integral and unsigned type.
+ *
+ * @tparam ty check type
+ */
+template<typename ty, typename = std::enable_if_t<std::is_integral_v<ty> && std::is_unsigned_v<ty>>>
+struct _integral_unsigned {};
+
+/**
+ * @brief Native unsigned integer tag, construct a BigUnsigned from its value.
+ *
+ */
+struct NATIVE {};
+
+// multiplication thresholds -------------------
+/**
+ * @brief Operands with at least this many digits (the shorter operand) are multiplied
+ *        with Karatsuba instead of schoolbook.
+ *
+ * <p> Not constant so it can be tuned, see bench_bigint. Must be >= 2. </p>
+ *
+ */
+std::size_t karatsuba_threshold = 32;
+
+/**
+ * @brief Operands with at least this many digits (the shorter operand) are multiplied
+ *        with Toom-3 instead of Karatsuba.
+ *
+ * <p> Not constant so it can be tuned, see bench_bigint. Should be >= 3 * karatsuba_threshold. </p>
+ *
+ */
+std::size_t toom3_threshold = 160;
+
+/**
+ * @brief Numbers with at least this many digits are squared with Karatsuba instead of
+ *        schoolbook. Higher than \p karatsuba_threshold since schoolbook squaring only
+ *        does half the digit multiplies.
+ *
+ * <p> Not constant so it can be tuned, see bench_bigint. Must be >= 2. </p>
+ *
+ */
+std::size_t karatsuba_sqr_threshold = 48;
+
+/**
+ * @brief Operands with at least this many digits (the shorter operand) have the sub products
+ *        of Karatsuba and Toom-3 computed in parallel, see bigint_threads.
+ *
+ * <p> Not constant so it can be tuned, see bench_bigint. </p>
+ *
+ */
+std::size_t parallel_mul_threshold = 1024;
+
+/**
+ * @brief Operands with at least this many digits (the shorter operand) are multiplied
+ *        with the number theoretic transform instead of Toom-3.
+ *
+ * <p> Not constant so it can be tuned, see bench_bigint. </p>
+ *
+ */
+std::size_t ntt_threshold = 4096;
+
+// base10 conversion -----------------------------
+/**
+ * @brief Statically usable power of 10.
+ *
+ */
+constexpr _ull pow10_const(_ui exp) {
+    _ull res = 1;
+    while (exp-- != 0) {
+        res *= 10;
+    }
+    return res;
+}
+
+/**
+ * @brief Number of base10 digits converted at a time. Largest power of 10 below \p BASE.
+ *
+ */
+constexpr _ui DEC_CHUNK_DIGITS = BASE_DIGITS_ALLOW;
+
+/**
+ * @brief 10 ^ \p DEC_CHUNK_DIGITS
+ *
+ */
+constexpr _limb DEC_CHUNK = static_cast<_limb>(pow10_const(DEC_CHUNK_DIGITS));
+
+/**
+ * @brief Numbers with at most this many digits are converted to base10 one chunk at a time,
+ *        larger ones are split in half by a cached power of 10 first.
+ *
+ */
+constexpr std::size_t DEC_CONVERSION_THRESHOLD = 24;
@@ -4,8 +4,11 @@
 
 #pragma once
 #include <BigInt.h>
+#include <BigInt_fixed.h>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <file_wrapper.h>
 #include <iostream>
 #include <prob_createInfo.h>
@@ -56,25 +59,11 @@ _std ostream& operator<< (_std ostream& out, const IndexInfo& info) {
     return out;
 }
 
-/**
- * @brief Rebind a primary template with one template paramter to a different parameter.
- * 
- * @tparam T type to substitute into primary
- * @tparam U primary template with old types to be replaced
- */
-template<typename T, typename U>
-struct Rebind;
-
-template<typename ty_new, template<typename> typename primary, typename... ty_old>
-struct Rebind<ty_new, primary<ty_old...>> {
-    using ty = primary<ty_new>;
-};
-
 using _bignum_val = _std integral_constant<_std size_t, sizeof(BigUnsigned::cont_ull::value_type)>;
 using _in64_sz = _std integral_constant<_std size_t, sizeof(int_least64_t)>;
 
 /**
- * @brief Write to file digits of a \p BigUnsigned
+ * @brief Write to file digits of a \p BigUnsigned or \p FixedUnsigned
  * 
  * <p> Have two cases of sizeof(BigUnsigned.digits::value_type) == sizeof(int_least64_t) then can just write normally (true).
  *     Otherwise must cast digits to int_least64_t (false).
@@ -91,13 +80,15 @@ struct _to_int64 {};
 template<>
 struct _to_int64<_std integral_constant<bool, true>> {
 
-    static auto write(_std ofstream* outf, BigUnsigned* num) {
+    template<typename Num>
+    static auto write(_std ofstream* outf, Num* num) {
 
         return write_block(outf, &(num->digits));
 
     }
 
-    static void read(_std ifstream* inf, BigUnsigned* num) {
+    template<typename Num>
+    static void read(_std ifstream* inf, Num* num) {
 
         read_block(inf, &(num->digits));
 
@@ -108,9 +99,10 @@ struct _to_int64<_std integral_constant<bool, true>> {
 template<>
 struct _to_int64<_std integral_constant<bool, false>> {
 
-    using cont_ty = typename Rebind<int_least64_t, typename BigUnsigned::cont_ull>::ty;
+    using cont_ty = _prob container_ty<int_least64_t>;
     
-    static auto write(_std ofstream* outf, BigUnsigned* num) {
+    template<typename Num>
+    static auto write(_std ofstream* outf, Num* num) {
 
         cont_ty new_digits(num->digits.size());
         auto iter_new_digits = new_digits.begin();
@@ -122,7 +114,8 @@ struct _to_int64<_std integral_constant<bool, false>> {
 
     }
 
-    static void read(_std ifstream* inf, BigUnsigned* num) {
+    template<typename Num>
+    static void read(_std ifstream* inf, Num* num) {
 
         cont_ty new_digits(num->digits.size());
 
@@ -130,7 +123,7 @@ struct _to_int64<_std integral_constant<bool, false>> {
 
         auto iter_num = num->digits.begin();
         for (auto iter_digit = new_digits.cbegin(); iter_digit != new_digits.cend(); ++iter_digit, ++iter_num) {
-            *iter_num = static_cast<BigUnsigned::cont_ull::value_type>(*iter_digit);
+            *iter_num = static_cast<typename Num::cont_ull::value_type>(*iter_digit);
         }
 
     }
@@ -140,12 +133,178 @@ struct _to_int64<_std integral_constant<bool, false>> {
 /**
  * @brief Initiate writing to file process.
  */
-auto _write_int64(_std ofstream* outf, BigUnsigned* num) {
+template<typename Num>
+auto _write_int64(_std ofstream* outf, Num* num) {
 
     return _to_int64<_std integral_constant<bool, _std is_same_v<_bignum_val, _in64_sz>>>::write(outf, num);
 
 }
 
+/**
+ * @brief How the edge probabilities are stored in the info file, recorded in its header.
+ * 
+ * <p> The fixed point formats are of precision10_value, U32 is exact while precision10_value
+ *     fits in 32 bits. U16 and U8 round to 1 / 65535 and 1 / 255 of it, FLOAT32 stores
+ *     the chance in [0,1]. Reading gives back precision10_value fixed point for all of them.
+ * </p>
+ * 
+ */
+enum class edge_format : int_least64_t { INT64 = 0, U32 = 1, U16 = 2, U8 = 3, FLOAT32 = 4 };
+
+/**
+ * @brief First 8 bytes of an info file with a header, "PPEDGES1". Files without it are
+ *        INT64 with no header.
+ * 
+ */
+constexpr int_least64_t info_magic = 0x3153454744455050;
+
+static_assert(precision10_value <= UINT32_MAX, "U32 stores precision10_value fixed point unchanged");
+
+/**
+ * @brief Bytes of one edge in \p format.
+ * 
+ */
+constexpr _std size_t edge_format_bytes(edge_format format) {
+
+    switch (format) {
+        case edge_format::U32: return sizeof(_std uint32_t);
+        case edge_format::U16: return sizeof(_std uint16_t);
+        case edge_format::U8: return sizeof(_std uint8_t);
+        case edge_format::FLOAT32: return sizeof(float);
+        default: return sizeof(int_least64_t);
+    }
+
+}
+
+/**
+ * @brief Levels of the U16 and U8 formats, 0 for the others.
+ * 
+ */
+constexpr int_least64_t _edge_format_levels(edge_format format) {
+
+    return format == edge_format::U16 ? UINT16_MAX : format == edge_format::U8 ? UINT8_MAX : 0;
+
+}
+
+/**
+ * @brief Store \p count edges of precision10_value fixed point in \p format.
+ * 
+ * @param out edge_format_bytes(format) * count bytes
+ */
+inline void _encode_edges(const int_least64_t* edges, size_t count, edge_format format, char* out) {
+
+    const auto levels = _edge_format_levels(format);
+    const auto bytes = edge_format_bytes(format);
+
+    for (size_t i = 0; i != count; ++i, out += bytes) {
+        switch (format) {
+            case edge_format::U32: {
+                const auto val = static_cast<_std uint32_t>(edges[i]);
+                _std memcpy(out, &val, bytes);
+                break;
+            }
+            case edge_format::U16: {
+                const auto val = static_cast<_std uint16_t>((edges[i] * levels + precision10_value / 2) / precision10_value);
+                _std memcpy(out, &val, bytes);
+                break;
+            }
+            case edge_format::U8: {
+                const auto val = static_cast<_std uint8_t>((edges[i] * levels + precision10_value / 2) / precision10_value);
+                _std memcpy(out, &val, bytes);
+                break;
+            }
+            case edge_format::FLOAT32: {
+                const auto val = static_cast<float>(static_cast<double>(edges[i]) / precision10_value);
+                _std memcpy(out, &val, bytes);
+                break;
+            }
+            default:
+                _std memcpy(out, &edges[i], bytes);
+        }
+    }
+
+}
+
+/**
+ * @brief Undo \p _encode_edges, the edges are precision10_value fixed point.
+ * 
+ */
+inline void _decode_edges(const char* in, size_t count, edge_format format, int_least64_t* edges) {
+
+    const auto levels = _edge_format_levels(format);
+    const auto bytes = edge_format_bytes(format);
+
+    for (size_t i = 0; i != count; ++i, in += bytes) {
+        switch (format) {
+            case edge_format::U32: {
+                _std uint32_t val;
+                _std memcpy(&val, in, bytes);
+                edges[i] = val;
+                break;
+            }
+            case edge_format::U16: {
+                _std uint16_t val;
+                _std memcpy(&val, in, bytes);
+                edges[i] = (val * precision10_value + levels / 2) / levels;
+                break;
+            }
+            case edge_format::U8: {
+                _std uint8_t val;
+                _std memcpy(&val, in, bytes);
+                edges[i] = (val * precision10_value + levels / 2) / levels;
+                break;
+            }
+            case edge_format::FLOAT32: {
+                float val;
+                _std memcpy(&val, in, bytes);
+                edges[i] = _std llround(static_cast<double>(val) * precision10_value);
+                break;
+            }
+            default:
+                _std memcpy(&edges[i], in, bytes);
+        }
+    }
+
+}
+
+/**
+ * @brief Read the header of an info file, leaves \p inf after it.
+ * 
+ * @return format of the edges, INT64 for files without a header
+ */
+inline edge_format _read_info_header(_std ifstream* inf) {
+
+    int_least64_t magic = 0;
+    int_least64_t format = 0;
+
+    inf->seekg(0);
+    read_block(inf, &magic, &format);
+
+    if (!*inf || magic != info_magic) {
+        inf->clear();
+        return edge_format::INT64;
+    }
+
+    return static_cast<edge_format>(format);
+
+}
+
+/**
+ * @brief Read \p count edges stored in \p format at the position of \p inf.
+ * 
+ */
+inline _prob container_ty<int_least64_t> _read_edges(_std ifstream* inf, int_least64_t count, edge_format format) {
+
+    _prob container_ty<int_least64_t> edges(static_cast<_std size_t>(count));
+    _prob container_ty<char> bytes(static_cast<_std size_t>(count) * edge_format_bytes(format));
+
+    inf->read(bytes.data(), static_cast<_std streamsize>(bytes.size()));
+    _decode_edges(bytes.data(), count, format, edges.data());
+
+    return edges;
+
+}
+
 /**
  * @brief Write information to info file corresponding to numbers in \p hashed
  * 
@@ -153,13 +312,20 @@ auto _write_int64(_std ofstream* outf, BigUnsigned* num) {
  *     created for every machine/ compiler each time.
  * </p>
  * 
+ * <p> Num is the type the number of paths is computed in, \p path_num_ty keeps them off
+ *     the heap. The file is the same for every Num.
+ * </p>
+ * 
+ * <p> The file starts with a header of \p info_magic and \p format. </p>
+ * 
  * @param name name of info file to write to
  * @param hashed container of hashed values in sorted order according to \p write_map
+ * @param format how the edge probabilities are stored, smaller formats round them
  * @return _prob container_ty<IndexInfo> Info's corresponding to \p hashed in same order  
  * 
  */
-template<typename T>
-_prob container_ty<IndexInfo> write_info(T name, const size_vec& hashed) {
+template<typename Num = BigUnsigned, typename T>
+_prob container_ty<IndexInfo> write_info(T name, const size_vec& hashed, edge_format format = edge_format::INT64) {
 
     _std ofstream outf{name, _std ios::binary};
 
@@ -167,31 +333,47 @@ _prob container_ty<IndexInfo> write_info(T name, const size_vec& hashed) {
         _std cerr << "cannot open writing file" << _std endl;
     }
 
-    _std streamsize bytes_written = 0; // total number of bytes written
+    int_least64_t magic = info_magic;
+    auto format_num = static_cast<int_least64_t>(format);
+    auto res_tuple_header = write_block(&outf, &magic, &format_num);
+
+    _std streamsize bytes_written = block_size_total(&res_tuple_header); // total number of bytes written
+    _prob container_ty<char> encoded; // one row of edges in format
+    request_arena arena; // memory of numbers for a single coordinate
+    const alloc_stats stats_start = bigint_alloc_stats; // counters before the first coordinate
     _prob container_ty<IndexInfo> index_vec(hashed.size());  // container containing info for locating numbers
     auto iter_index_vec = index_vec.begin();
     for (auto iter_hashed = hashed.cbegin(); iter_hashed != hashed.cend(); ++iter_hashed, ++iter_index_vec) {
 
+            arena_scope scope(&arena);
+
             const auto unhashed = unhash(*iter_hashed); // unhashed coords
 
             _std cout << unhashed.first << "," << unhashed.second << " | ";
 
-            BigUnsigned num_paths = path_num_end(unhashed); // number of paths
+            Num num_paths = path_num_end<Num>(unhashed); // number of paths
             auto res_tuple_path = _write_int64(&outf, &num_paths); // number of paths
-            auto res_edge = edge_prob(unhashed, INT_LEAST64{}); // highlight lines
-                                                                // Note: this writes out the starting probability
 
-            auto res_tuple_edge = write_block(&outf, &res_edge);
+            int_least64_t num_edges = 0; // highlight lines, written a row at a time so the whole container is never in memory
+                                         // Note: this writes out the starting probability
+            edge_prob_rows(unhashed, INT_LEAST64{}, [&](const int_least64_t* edges, size_t count) {
+                encoded.resize(static_cast<_std size_t>(count) * edge_format_bytes(format));
+                _encode_edges(edges, count, format, encoded.data());
+                outf.write(encoded.data(), static_cast<_std streamsize>(encoded.size()));
+                num_edges += count;
+            });
 
             *iter_index_vec = IndexInfo(*iter_hashed, static_cast<int_least64_t>(bytes_written), 
                                                       static_cast<int_least64_t>(num_paths.digits.size()), 
-                                                      static_cast<int_least64_t>(res_edge.size()));
+                                                      num_edges);
 
-            auto total_tuple = _std tuple_cat(res_tuple_path, res_tuple_edge);
-            bytes_written += block_size_total(&total_tuple);
+            bytes_written += block_size_total(&res_tuple_path) + static_cast<_std streamsize>(static_cast<_std size_t>(num_edges) * edge_format_bytes(format));
 
     }
 
+    const auto stats = bigint_alloc_stats - stats_start; // every coordinate together
+    _std cout << _std endl << "allocations saved " << stats.saved() << " of " << stats.requested << _std endl;
+
     outf.close();
     if (outf.fail()) {
         _std cerr << "cannot close writing file" << _std endl;
@@ -249,7 +431,8 @@ void write_map(T name, const _prob container_ty<IndexInfo>& index_vec) {
 /**
  * @brief Initiate reading from file process.
  */
-auto _read_int64(_std ifstream* inf, BigUnsigned* num) {
+template<typename Num>
+auto _read_int64(_std ifstream* inf, Num* num) {
 
     return _to_int64<_std integral_constant<bool, _std is_same_v<_bignum_val, _in64_sz>>>::read(inf, num);
 
@@ -262,14 +445,15 @@ auto _read_int64(_std ifstream* inf, BigUnsigned* num) {
  * @param name_info info file name
  * @param coord coordinate to get information for
  * @param _ tag to reference wanted function
- * @return _std pair<BigUnsigned, _prob container_ty<int_least64_t>> return pair of 
- *         <p> first) Number of paths to point
- *             <br> second) Chance that path uses edge. Returned in precision defined by \p precision10_value
+ * @return _std pair<Num, _prob container_ty<int_least64_t>> return pair of 
+ *         <p> first) Number of paths to point, read into a Num like in \p write_info
+ *             <br> second) Chance that path uses edge. Returned in precision defined by \p precision10_value,
+ *                  rounded by the \p edge_format of the file
  *         </p>
  * 
  */
-template<typename T, typename U>
-_std pair<BigUnsigned, _prob container_ty<int_least64_t>> read_map(T name_map, U name_info, coord_ty coord, INT_LEAST64 _) {
+template<typename Num = BigUnsigned, typename T, typename U>
+_std pair<Num, _prob container_ty<int_least64_t>> read_map(T name_map, U name_info, coord_ty coord, INT_LEAST64 _) {
 
     auto hashed_coord = _prob hash(coord); // hashed coord
 
@@ -299,13 +483,14 @@ _std pair<BigUnsigned, _prob container_ty<int_least64_t>> read_map(T name_map, U
         _std cerr << "cannot open info file" << _std endl;
     }
 
+    const auto format = _read_info_header(&inf_info); // how edges are stored
+
     inf_info.seekg(info.start); // seek to position of data
 
-    BigUnsigned num_paths(info.size_paths); // number of paths
+    Num num_paths(info.size_paths); // number of paths
     _read_int64(&inf_info, &num_paths);
 
-    _prob container_ty<int_least64_t> edges_prob_int64(info.size_edges); // edge probabilities
-    read_block(&inf_info, &edges_prob_int64); // read in info
+    auto edges_prob_int64 = _read_edges(&inf_info, info.size_edges, format); // edge probabilities
 
     inf_info.close();
 
@@ -324,14 +509,15 @@ _std pair<BigUnsigned, _prob container_ty<int_least64_t>> read_map(T name_map, U
  * @param name_info info file name
  * @param coord coordinate to get information for
  * @param _ tag to reference wanted function
- * @return _std pair<BigUnsigned, _prob container_ty<int_least64_t>> return pair of 
- *         <p> first) Number of paths to point
- *             <br> second) Chance that path uses edge. Returned in range [0,1].
+ * @return _std pair<Num, _prob container_ty<double>> return pair of 
+ *         <p> first) Number of paths to point, read into a Num like in \p write_info
+ *             <br> second) Chance that path uses edge. Returned in range [0,1], rounded by the
+ *                  \p edge_format of the file
  *         </p>
  * 
  */
-template<typename T, typename U>
-_std pair<BigUnsigned, _prob container_ty<double>> read_map(T name_map, U name_info, coord_ty coord, DOUBLE _) {
+template<typename Num = BigUnsigned, typename T, typename U>
+_std pair<Num, _prob container_ty<double>> read_map(T name_map, U name_info, coord_ty coord, DOUBLE _) {
 
     auto hashed_coord = _prob hash(coord); // hashed coord
 
@@ -361,13 +547,14 @@ _std pair<BigUnsigned, _prob container_ty<double>> read_map(T name_map, U name_i
         _std cerr << "cannot open info file" << _std endl;
     }
 
+    const auto format = _read_info_header(&inf_info); // how edges are stored
+
     inf_info.seekg(info.start); // seek to position of data
 
-    BigUnsigned num_paths(info.size_paths); // number of paths
+    Num num_paths(info.size_paths); // number of paths
     _read_int64(&inf_info, &num_paths);
 
-    _prob container_ty<int_least64_t> edges_prob_int64(info.size_edges); // edge probabilities
-    read_block(&inf_info, &edges_prob_int64); // read in info
+    auto edges_prob_int64 = _read_edges(&inf_info, info.size_edges, format); // edge probabilities
 
     inf_info.close();
 
@@ -10,7 +10,11 @@
 #include <iomanip>
 #include <iterator>
 #include <BigInt.h>
+#include <BigInt_fixed.h>
 #include <limits>
+#include <map>
+#include <prob_simd.h>
+#include <prob_tables.h>
 #include <prob_utils.h>
 #include <prob_vars.h>
 #include <vector>
@@ -25,15 +29,27 @@ start_probability
        So it is not necessary to multiply by the number of paths
        after the point since there are none.
  * </p>
+ * <p> (x + y) choose x, see \p binomial. Read from \p path_nums when there. </p>
+ * <p> Num is BigUnsigned or a FixedUnsigned like \p path_num_ty. </p>
  * 
  */
-BigUnsigned path_num_end(coord_ty end) {
+template<typename Num = BigUnsigned>
+Num path_num_end(coord_ty end) {
+
+    if (in_tables(end)) {
+        if constexpr (_std is_same_v<Num, path_num_ty>) {
+            return path_nums[end.first][end.second];
+        } else if constexpr (_std is_same_v<Num, BigUnsigned>) {
+            return to_BigUnsigned(path_nums[end.first][end.second]);
+        }
+    }
 
-    return smart_factorial(end.first + end.second) / (smart_factorial(end.first) * smart_factorial(end.second));
+    return binomial<Num>(end.first + end.second, end.first);
 
 }
 
-BigUnsigned path_num_rel(coord_ty point, coord_ty end) {
+template<typename Num = BigUnsigned>
+Num path_num_rel(coord_ty point, coord_ty end) {
     // Usage: get number of paths through a point
     // Explanation: assume the given point is anywhere on the grid. This means
     //              the total number of paths is the number before and after
@@ -41,7 +57,7 @@ BigUnsigned path_num_rel(coord_ty point, coord_ty end) {
     // <point> coords of point
     // <end> coords of ending point
 
-    return path_num_end(point) * path_num_end(relative(end, point));
+    return path_num_end<Num>(point) * path_num_end<Num>(relative(end, point));
 
 }
 
@@ -49,24 +65,16 @@ BigUnsigned path_num_rel(coord_ty point, coord_ty end) {
  * @brief Probability that path goes through a coordinate relative to end coordinate.
  * 
  * <p> Assume path_point <= path_end </p>
+ * <p> Nearest double to the ratio, see \p ratio_to_double. </p>
  * 
  * @param path_point number of paths through required coordinate
  * @param path_end number of paths through end coordinate
  * 
  */
-double chance_path(const BigUnsigned& path_point, const BigUnsigned& path_end) {
-
-    assert(_std numeric_limits<double>::digits10 >= precision10_digits && "no loss precision of double must be >= to precision10_digits");
+template<typename Num>
+double chance_path(const Num& path_point, const Num& path_end) {
 
-    auto res = (path_end * BigUnsigned("1" + _std string(precision10_digits - 1, '0'))) / path_point;
-
-    double as_dbl = BigUnsigned_10_dbl(res);
-
-    if (as_dbl == -1) {
-        return -1;
-    }
-
-    return static_cast<double>(precision10_value) * (1.0 / as_dbl); // assert needed here
+    return ratio_to_double(path_point, path_end);
 
 }
 
@@ -74,13 +82,105 @@ double chance_path(const BigUnsigned& path_point, const BigUnsigned& path_end) {
  * @brief Probability that path goes through a coordinate relative to end coordinate.
  * 
  * <p> Assume point.first <= end.first && point.second <= end.second </p>
+ * <p> Up to max_grid_sz the paths come from \p path_nums, so nothing is computed
+ *     or allocated before the division.
+ * </p>
  * 
  * @param point required coordinate coordinate 
  * @param end end coordinate
  */
 double chance_path(coord_ty point, coord_ty end) {
 
-    return chance_path(path_num_end(point) * path_num_end(relative(end, point)), path_num_end(end));
+    assert(point.first >= 0 && point.second >= 0 && point.first <= end.first && point.second <= end.second && "point must be in the grid of end");
+
+    if (in_tables(end) && in_tables(point)) {
+        const auto rel = relative(end, point);
+        return chance_path(path_nums[point.first][point.second] * path_nums[rel.first][rel.second], path_nums[end.first][end.second]);
+    }
+
+    // cancel the primes shared by the paths through point and all paths,
+    //     only the reduced fraction is built
+    const auto rel = relative(end, point);
+
+    container_ty<int_least64_t> exps;
+    _binomial_exps(point.first + point.second, point.first, 1, &exps);
+    _binomial_exps(rel.first + rel.second, rel.first, 1, &exps);
+    _binomial_exps(end.first + end.second, end.first, -1, &exps);
+
+    const auto& primes = primes_upto(end.first + end.second);
+
+    return chance_path(_prime_product(primes, exps, 1), _prime_product(primes, exps, -1));
+
+}
+
+/**
+ * @brief Probability that a path to \p end goes through each coordinate of [first, last).
+ * 
+ * <p> Assume every point <= end (both coordinates) </p>
+ * <p> Same values as \p chance_path for each point. The prime exponents of a factorial are
+ *     computed once and shared, so the terms of \p end and the factorials neighbouring
+ *     points have in common are done once for the whole batch.
+ * </p>
+ * 
+ * @param first iterator to coord_ty
+ * @return chances in the order of the points
+ */
+template<typename It>
+container_ty<double> chance_path_batch(coord_ty end, It first, It last) {
+
+    container_ty<double> res;
+
+    if (in_tables(end)) {
+        for (; first != last; ++first) {
+            res.push_back(chance_path(*first, end));
+        }
+        return res;
+    }
+
+    const auto& primes = primes_upto(end.first + end.second);
+    const auto num_primes = _std upper_bound(primes.cbegin(), primes.cend(), end.first + end.second) - primes.cbegin();
+
+    _std map<size_t, container_ty<int_least64_t>> fac_exps; // exponent of every prime in num!, by num
+    const auto factorial_exps = [&](size_t num) -> const container_ty<int_least64_t>& {
+        auto iter = fac_exps.find(num);
+        if (iter == fac_exps.end()) {
+            container_ty<int_least64_t> exps;
+            for (size_t i = 0; i != num_primes && primes[i] <= num; ++i) {
+                exps.push_back(static_cast<int_least64_t>(_legendre(num, primes[i])));
+            }
+            iter = fac_exps.emplace(num, _std move(exps)).first;
+        }
+        return iter->second;
+    };
+
+    // sign times the exponents of n choose k = n! / (k! (n - k)!)
+    const auto add_binomial = [&](size_t n, size_t k, int sign, container_ty<int_least64_t>* exps) {
+        const _std pair<size_t, int> terms[] = { {n, sign}, {k, -sign}, {n - k, -sign} };
+        for (const auto& term : terms) {
+            const auto& fac = factorial_exps(term.first);
+            for (_std size_t i = 0; i != fac.size(); ++i) {
+                (*exps)[i] += term.second * fac[i];
+            }
+        }
+    };
+
+    container_ty<int_least64_t> end_exps(static_cast<_std size_t>(num_primes), 0);
+    add_binomial(end.first + end.second, end.first, -1, &end_exps);
+
+    container_ty<int_least64_t> exps;
+    for (; first != last; ++first) {
+        const coord_ty point = *first;
+        assert(point.first >= 0 && point.second >= 0 && point.first <= end.first && point.second <= end.second && "point must be in the grid of end");
+        const auto rel = relative(end, point);
+
+        exps = end_exps;
+        add_binomial(point.first + point.second, point.first, 1, &exps);
+        add_binomial(rel.first + rel.second, rel.first, 1, &exps);
+
+        res.push_back(chance_path(_prime_product(primes, exps, 1), _prime_product(primes, exps, -1)));
+    }
+
+    return res;
 
 }
 
@@ -104,50 +204,13 @@ auto edge_prob(coord_ty end, DOUBLE _) {
     prob_vec::size_type size = static_cast<prob_vec::size_type>(1 + (end.first * (end.second + 1)) + ((end.first + 1) * end.second));
     prob_vec res(size, 100); // container for all percentages
 
-    double remaining_moves = end.first + end.second; // dangerous from size_t to double, might not be enough space in double
-
-    auto res_iter = res.begin();
-    *res_iter = 100;
-    ++res_iter;
-
     if (end.first == 0 || end.second == 0) {
         return res;
     }
 
-    for (size_t i = 0; i != end.first; ++i, ++res_iter) { // first row of horizontal edges
-        *res_iter = *(res_iter - 1) * ((end.first - i) / (remaining_moves - i));
-    }
-
-    for (size_t i = 0; i != end.first + 1; ++i, ++res_iter) { // first row of vertical edges
-        *res_iter = *(res_iter - end.first - 1) * (end.second / (remaining_moves - i));
-    }
-
-    for (size_t i = 0; i != end.second - 1; ++i) {
-
-        --remaining_moves;
-
-        // horizontal
-        *res_iter = *(res_iter - end.first - 1) * (end.first / remaining_moves);
-        ++res_iter;
-        for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) {
-            *res_iter = (*(res_iter - 1) + *(res_iter - end.first - 1)) * ((end.first - j - 1) / (remaining_moves - j - 1));
-        }
-
-        // vertical
-        *res_iter = *(res_iter - (2 * end.first) - 1) * ((end.second - i - 1) / remaining_moves);
-        ++res_iter;
-        for (size_t j = 0; j != end.first; ++j, ++res_iter) {
-            *res_iter = (*(res_iter - end.first - 1) + *(res_iter - (2 * end.first) - 1)) * ((end.second - i - 1) / (remaining_moves - j -1));
-        }
-
-    }
-
-    --remaining_moves;
-    *res_iter = *(res_iter - end.first - 1) * (end.first / remaining_moves);
-    ++res_iter;
-    for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) { // last row of horizontal edges
-        *res_iter = (*(res_iter - 1) + *(res_iter - end.first - 1)) * ((end.first - j - 1) / (remaining_moves - j - 1));
-    }
+    // edge chance is the chance of reaching its start, (left + below), times the chance of
+    //     taking it, a band of rows is done at once so the rows run side by side
+    _edge_fill(res.data(), end, DOUBLE{});
 
     return res;
 
@@ -158,7 +221,11 @@ auto edge_prob(coord_ty end, DOUBLE _) {
  *        for all edges of that coordinate. Probability not in [0,1] range, adjusted for
  *        system int size. 
  * 
- * <p> No reliance on double. Should be preferred function to use for database creation. </p>
+ * <p> No rounding by double, the quotients computed in double are exact. Should be preferred
+ *     function to use for database creation. </p>
+ * <p> The edge chances are the same for the grid turned around, but the values are not since
+ *     every step rounds down. Mirroring half the grid would change the stored values and was
+ *     measured at 0.8 to 1.4 times the speed of the band kernels, so every edge is computed. </p>
  * 
  * @param end
  * @param _ tag to reference wanted function
@@ -175,55 +242,263 @@ auto edge_prob(coord_ty end, INT_LEAST64 _) {
     prob_vec::size_type size = static_cast<prob_vec::size_type>(1 + (end.first * (end.second + 1)) + ((end.first + 1) * end.second));
     prob_vec res(size, precision10_value); // container for all percentages
 
-    int_least64_t remaining_moves = end.first + end.second;
-
-    auto res_iter = res.begin();
-    *res_iter = precision10_value;
-    ++res_iter;
-
     if (end.first == 0 || end.second == 0) {
         return res;
     }
 
-    for (size_t i = 0; i != end.first; ++i, ++res_iter) { // first row of horizontal edges        
-        *res_iter = (*(res_iter - 1) * ((precision10_value * (end.first - i)) / (remaining_moves - i))) / precision10_value;
+    // same as the DOUBLE version, the quotients are exact in double since the
+    //     numerators are below 2^53
+    _edge_fill(res.data(), end, INT_LEAST64{});
+
+    return res;
+
+}
+
+/**
+ * @brief Number of edges in the \p edge_prob container for \p end, including the first element.
+ * 
+ */
+inline size_t edge_count(coord_ty end) {
+
+    return 1 + (end.first * (end.second + 1)) + ((end.first + 1) * end.second);
+
+}
+
+/**
+ * @brief Split paths using edge \p index of the \p edge_prob order into the part before
+ *        and the part after the edge.
+ * 
+ * <p> Assume 0 < index < edge_count(end) </p>
+ * 
+ * @return _std pair<coord_ty, coord_ty> first) coordinate the edge starts at
+ *         <br> second) coordinate the edge ends at relative to \p end
+ */
+inline _std pair<coord_ty, coord_ty> _edge_split(coord_ty end, size_t index) {
+
+    const auto row = (index - 1) / (2 * end.first + 1); // a row is end.first horizontal then end.first + 1 vertical edges
+    const auto col = (index - 1) % (2 * end.first + 1);
+
+    if (col < end.first) { // horizontal, (col, row) to (col + 1, row)
+        return _std pair(coord_ty(col, row), coord_ty(end.first - col - 1, end.second - row));
+    }
+
+    return _std pair(coord_ty(col - end.first, row), coord_ty(end.first - (col - end.first), end.second - row - 1)); // vertical
+
+}
+
+/**
+ * @brief log of the number of paths through a point, see \p path_num_end.
+ * 
+ * @param log_facs from \p log_factorials_upto of at least coord.first + coord.second
+ */
+inline long double _log_path_num(coord_ty coord, const container_ty<long double>& log_facs) {
+
+    return log_facs[coord.first + coord.second] - log_facs[coord.first] - log_facs[coord.second];
+
+}
+
+/**
+ * @brief Probability in [0,1] that a path to \p end uses the edge split by \p split,
+ *        paths through the edge over all paths.
+ * 
+ * <p> Grids in \p path_nums are exact, others use \p log_facs. </p>
+ * 
+ * @param split from \p _edge_split
+ * @param log_facs from \p log_factorials_upto of at least end.first + end.second, only read
+ *                 when \p end is not in \p path_nums
+ */
+double _edge_chance(coord_ty end, const _std pair<coord_ty, coord_ty>& split, const container_ty<long double>& log_facs) {
+
+    if (in_tables(end)) {
+        return chance_path(path_nums[split.first.first][split.first.second] * path_nums[split.second.first][split.second.second],
+                           path_nums[end.first][end.second]);
     }
 
-    for (size_t i = 0; i != end.first + 1; ++i, ++res_iter) { // first row of vertical edges
-        *res_iter = (*(res_iter - end.first - 1) * ((precision10_value * end.second) / (remaining_moves - i))) / precision10_value;
+    return static_cast<double>(_std exp(_log_path_num(split.first, log_facs) + _log_path_num(split.second, log_facs) - _log_path_num(end, log_facs)));
+
+}
+
+/**
+ * @brief Probability in [0,1] as an element of the DOUBLE \p edge_prob container.
+ * 
+ */
+inline double _edge_value(double chance, DOUBLE _) {
+
+    return 100 * chance;
+
+}
+
+/**
+ * @brief Probability in [0,1] as an element of the INT_LEAST64 \p edge_prob container.
+ * 
+ */
+inline int_least64_t _edge_value(double chance, INT_LEAST64 _) {
+
+    return static_cast<int_least64_t>(_std llround(chance * precision10_value));
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(1). Element \p index of \p edge_prob for \p end without
+ *        computing the others.
+ * 
+ * <p> Paths using edge (i, j) to (i + 1, j) are C(i + j, i) * C(X - i - 1 + Y - j, Y - j),
+ *     and over all C(X + Y, X) paths that is the chance. Vertical edges alike.
+ * </p>
+ * <p> Grids within max_grid_sz round the exact chance once. Grids past it go through
+ *     \p log_factorials_upto, about 1e-13 relative error at 100000 x 100000, and the
+ *     first call for a grid takes theta(X + Y).
+ * </p>
+ * <p> These values do not reproduce the stored ones. The INT_LEAST64 \p edge_prob rounds
+ *     down at every step of the recurrence, so it sits below the exact chance by an amount
+ *     growing with the grid, about 2e-6 of precision10_value at 20 x 20 and 5e-4 at
+ *     651 x 680. DOUBLE agrees with \p edge_prob to about 1e-15 of 100. Info files are
+ *     written from \p edge_prob, so that is canonical, use these only where nothing is
+ *     compared against the database.
+ * </p>
+ * 
+ * @param end end coordinate
+ * @param index position in the \p edge_prob container, 0 is the first element which is
+ *              not an edge
+ * @param tag DOUBLE or INT_LEAST64 for the matching \p edge_prob
+ */
+template<typename Tag>
+auto edge_prob_at(coord_ty end, size_t index, Tag tag) {
+
+    assert(index >= 0 && index < edge_count(end) && "edge index out of range");
+
+    if (index == 0) {
+        return _edge_value(1.0, tag);
     }
 
-    for (size_t i = 0; i != end.second - 1; ++i) {
+    const container_ty<long double> no_log_facs;
+    const auto& log_facs = in_tables(end) ? no_log_facs : log_factorials_upto(end.first + end.second);
 
-        --remaining_moves;
+    return _edge_value(_edge_chance(end, _edge_split(end, index), log_facs), tag);
 
-        // horizontal
-        *res_iter = (*(res_iter - end.first - 1) * ((precision10_value * end.first) / remaining_moves)) / precision10_value;
-        ++res_iter;
-        for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) {
-            *res_iter = ((*(res_iter - 1) + *(res_iter - end.first - 1)) * ((precision10_value * (end.first - j - 1)) / (remaining_moves - j - 1))) / precision10_value;
-        }
+}
 
-        // vertical
-        *res_iter = (*(res_iter - (2 * end.first) - 1) * ((precision10_value * (end.second - i - 1)) / remaining_moves)) / precision10_value;
-        ++res_iter;
-        for (size_t j = 0; j != end.first; ++j, ++res_iter) {
-            *res_iter = ((*(res_iter - end.first - 1) + *(res_iter - (2 * end.first) - 1)) * ((precision10_value * (end.second - i - 1)) / (remaining_moves - j -1))) / precision10_value;
-        }
+/**
+ * @brief <b> Fast </b> - theta(edges in region). The edges of \p edge_prob for \p end which
+ *        lie in the rectangle from \p first to \p last, without computing the others.
+ * 
+ * <p> Assume first <= last <= end (both coordinates). </p>
+ * <p> Same order as \p edge_prob for a grid of last - first, but there is no first element
+ *     which is not an edge. See \p edge_prob_at for the values.
+ * </p>
+ * 
+ * @param tag DOUBLE or INT_LEAST64 for the matching \p edge_prob
+ */
+template<typename Tag>
+auto edge_prob_region(coord_ty end, coord_ty first, coord_ty last, Tag tag) {
+
+    using prob_vec = _prob container_ty<decltype(_edge_value(0.0, tag))>;
 
+    const auto size = relative(last, first);
+    prob_vec res;
+    res.reserve(static_cast<typename prob_vec::size_type>(edge_count(size) - 1));
+
+    const container_ty<long double> no_log_facs;
+    const auto& log_facs = in_tables(end) ? no_log_facs : log_factorials_upto(end.first + end.second);
+
+    for (size_t row = first.second; row <= last.second; ++row) {
+        for (size_t col = first.first; col != last.first; ++col) { // horizontal
+            const auto split = _std pair(coord_ty(col, row), coord_ty(end.first - col - 1, end.second - row));
+            res.push_back(_edge_value(_edge_chance(end, split, log_facs), tag));
+        }
+        if (row == last.second) {
+            break;
+        }
+        for (size_t col = first.first; col <= last.first; ++col) { // vertical
+            const auto split = _std pair(coord_ty(col, row), coord_ty(end.first - col, end.second - row - 1));
+            res.push_back(_edge_value(_edge_chance(end, split, log_facs), tag));
+        }
     }
 
-    --remaining_moves;
-    *res_iter = (*(res_iter - end.first - 1) * ((precision10_value * end.first) / remaining_moves)) / precision10_value;
-    ++res_iter;
-    for (size_t j = 0; j != end.first - 1; ++j, ++res_iter) { // last row of horizontal edges
-        *res_iter = ((*(res_iter - 1) + *(res_iter - end.first - 1)) * ((precision10_value * (end.first - j - 1)) / (remaining_moves - j - 1))) / precision10_value;
+    return res;
+
+}
+
+/**
+ * @brief <b> Slow </b> - theta(edges / threads). \p edge_prob computed by \p bigint_threads
+ *        threads, for large grids.
+ * 
+ * <p> The grid is split into tiles of edge_tile_rows by edge_tile_cols, see \p _edge_fill_tiles.
+ *     The output is identical to \p edge_prob.
+ * </p>
+ * 
+ * @param tag DOUBLE or INT_LEAST64 for the matching \p edge_prob
+ */
+template<typename Tag>
+auto edge_prob_parallel(coord_ty end, Tag tag) {
+
+    using prob_vec = _prob container_ty<decltype(_edge_value(0.0, tag))>;
+
+    prob_vec res(static_cast<typename prob_vec::size_type>(edge_count(end)), _edge_value(1.0, tag));
+
+    if (end.first == 0 || end.second == 0) {
+        return res;
     }
 
+    _edge_fill_tiles(res.data(), end, tag);
+
     return res;
 
 }
 
+/**
+ * @brief <b> Slow </b> - theta(edges). \p edge_prob one row of the grid at a time, keeping
+ *        theta(end.first) memory instead of the whole container.
+ * 
+ * <p> \p sink is called as sink(const T* edges, size_t count) with the horizontal then the
+ *     vertical edges of each row, from the bottom up. The first call starts with the first
+ *     element and the last row has no vertical edges, so all calls together are the
+ *     \p edge_prob container. The edges are identical to \p edge_prob.
+ * </p>
+ * 
+ * @param tag DOUBLE or INT_LEAST64 for the matching \p edge_prob
+ * @param sink called once per row, the edges are only valid during the call
+ */
+template<typename Tag, typename Sink>
+void edge_prob_rows(coord_ty end, Tag tag, Sink&& sink) {
+
+    using value_ty = decltype(_edge_value(0.0, tag));
+
+    if (end.first == 0 || end.second == 0) {
+        const container_ty<value_ty> res(static_cast<_std size_t>(edge_count(end)), _edge_value(1.0, tag));
+        sink(res.data(), static_cast<size_t>(res.size()));
+        return;
+    }
+
+    _edge_assert_exact(end);
+
+    // first element, then the row below the band, then the band
+    const auto stride = 2 * end.first + 1;
+    const auto band = _edge_band_rows();
+    container_ty<value_ty> buf(static_cast<_std size_t>(1 + (band + 1) * stride));
+    buf[0] = _edge_value(1.0, tag);
+
+    for (size_t row = 0; row <= end.second; row += band) {
+
+        value_ty* const rows = buf.data() + 1 + (row == 0 ? 0 : stride); // row 0 goes right after the first element
+        _edge_band(rows, end, row, 0, end.first + 1, tag);
+
+        const auto lanes = _std min(band, end.second - row + 1);
+        for (size_t k = 0; k != lanes; ++k) {
+            const auto count = row + k == end.second ? end.first : stride;
+            if (row + k == 0) {
+                sink(static_cast<const value_ty*>(buf.data()), 1 + count);
+            } else {
+                sink(static_cast<const value_ty*>(rows + k * stride), count);
+            }
+        }
+
+        _std copy(rows + (lanes - 1) * stride, rows + lanes * stride, buf.data() + 1); // below the next band
+
+    }
+
+}
+
 /**
  * @brief depreciated
  * 
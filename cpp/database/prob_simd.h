@@ -0,0 +1,524 @@
+// Author: Dennis Yakovlev
+
+// File containing the kernels filling the edge_prob container. Every kernel has a scalar,
+//     AVX2 and AVX-512 version giving the same results, picked at run time, and
+//     large grids can be filled in tiles by several threads.
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <BigInt_thread.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <prob_vars.h>
+#include <thread>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PROB_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define PROB_SIMD_X86 0
+#endif
+
+start_probability
+
+/**
+ * @brief Instruction sets the kernels can use, ordered from least to most.
+ *
+ */
+enum class simd_level { SCALAR, AVX2, AVX512 };
+
+/**
+ * @brief Best instruction set of the cpu running the program.
+ *
+ */
+inline simd_level _detect_simd() {
+
+#if PROB_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        return simd_level::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return simd_level::AVX2;
+    }
+#endif
+
+    return simd_level::SCALAR;
+
+}
+
+/**
+ * @brief Instruction set used by the kernels. Change with \p set_edge_simd.
+ *
+ */
+simd_level edge_simd = _detect_simd();
+
+/**
+ * @brief Set \p edge_simd, lowered to what the cpu has.
+ *
+ */
+void set_edge_simd(simd_level level) {
+
+    edge_simd = _std min(level, _detect_simd());
+
+}
+
+// The edges of a row only depend on the row itself and the vertical edges below it,
+// so a band of rows is done together with each row a column behind the one below it.
+// Row k of the band is at column t - k on step t, and gets the vertical edge below it
+// from row k - 1 of the previous step. Every edge is computed with the same operations
+// as going row by row, only the order changes, so the results are identical.
+//
+// Paths reach (c, row) from the left or from below, chance s = left + below. The edge
+// to the right is s * (X - c) / (R - c) and the edge up is s * (Y - row) / (R - c),
+// with R = X + Y - row the moves left from the start of the row. R - c is the same
+// for every row of the band on a step.
+//
+// A band can stop at any column and carry on later from the edges it left, which lets
+// edge_prob_parallel split the grid into tiles. Column c of a row is the horizontal
+// edge leaving (c, row), if c < X, and the vertical edge leaving it.
+//
+// Kernels get rows, the edges of the first row of the band in the edge_prob order.
+// The row below is right before it, and before row 0 is the first element, so the
+// rows do not have to be in the whole container (see edge_prob_rows).
+
+static_assert(precision10_value < (static_cast<int_least64_t>(1) << 31), "fixed point products must fit 32 bit operands");
+
+/**
+ * @brief Chance of an edge in the DOUBLE edge_prob.
+ *
+ */
+inline double _edge_cell(double s, double num, double den, DOUBLE _) {
+
+    return s * (num / den);
+
+}
+
+/**
+ * @brief Chance of an edge in the INT_LEAST64 edge_prob, \p num is scaled by precision10_value.
+ *
+ * <p> num and den are integers below 2^53, so the double quotient rounded down is the
+ *     integer quotient.
+ * </p>
+ *
+ */
+inline int_least64_t _edge_cell(int_least64_t s, double num, double den, INT_LEAST64 _) {
+
+    return (s * static_cast<int_least64_t>(num / den)) / precision10_value;
+
+}
+
+/**
+ * @brief Chance of the edges into column \p first of each row of the band.
+ *
+ */
+template<typename T>
+inline void _edge_band_left(const T* rows, coord_ty end, size_t row, size_t first, size_t lanes, T* left) {
+
+    const auto stride = 2 * end.first + 1;
+
+    for (size_t k = 0; k != lanes; ++k) {
+        if (first != 0) {
+            left[k] = rows[k * stride + first - 1];
+        } else {
+            left[k] = row + k == 0 ? rows[-1] : T(); // paths start with the first element
+        }
+    }
+
+}
+
+/**
+ * @brief Fill columns [first, last) of rows [row, row + 4), see above.
+ *
+ * @param scale 1 for DOUBLE, precision10_value for INT_LEAST64
+ */
+template<typename T, typename Tag>
+void _edge_band_scalar(T* rows, coord_ty end, size_t row, size_t first, size_t last, double scale, Tag tag) {
+
+    constexpr size_t band = 4;
+    const auto width = static_cast<_std size_t>(end.first);
+    const auto stride = 2 * width + 1;
+    const auto lanes = _std min(band, end.second - row + 1);
+    const T* const below = row == 0 ? nullptr : rows - stride + width;
+
+    T left[band] = {}; // chance of the last edge into each row
+    T up[band] = {}; // last vertical edge of each row
+    _edge_band_left(rows, end, row, first, lanes, left);
+
+    for (size_t t = first; t != last + lanes - 1; ++t) {
+        const auto den = static_cast<double>(end.first + end.second - row - t);
+        for (auto k = lanes - 1; k >= 0; --k) { // downwards, up[k - 1] is still from the last step
+            const auto c = t - k;
+            if (c < first || c >= last) {
+                continue;
+            }
+            const T s = left[k] + (k != 0 ? up[k - 1] : below != nullptr ? below[c] : T());
+            T* const cell = rows + static_cast<_std size_t>(k) * stride + static_cast<_std size_t>(c);
+            if (c < end.first) {
+                left[k] = *cell = _edge_cell(s, scale * static_cast<double>(end.first - c), den, tag);
+            }
+            if (row + k < end.second) {
+                up[k] = cell[width] = _edge_cell(s, scale * static_cast<double>(end.second - row - k), den, tag);
+            }
+        }
+    }
+
+}
+
+#if PROB_SIMD_X86
+
+/**
+ * @brief Write lanes \p h and \p v of step \p t to the container, see \p _edge_band_scalar.
+ *
+ */
+template<typename T>
+inline void _edge_band_store(T* rows, coord_ty end, size_t row, size_t first, size_t last, size_t t, size_t lanes, const T* h, const T* v) {
+
+    const auto width = static_cast<_std size_t>(end.first);
+    const auto stride = 2 * width + 1;
+
+    const auto k_first = _std max<size_t>(0, t - last + 1);
+    const auto k_last = _std min<size_t>(lanes - 1, t - first);
+    for (auto k = k_first; k <= k_last; ++k) {
+        const auto c = t - k;
+        T* const cell = rows + static_cast<_std size_t>(k) * stride + static_cast<_std size_t>(c);
+        if (c < end.first) {
+            *cell = h[k];
+        }
+        if (row + k < end.second) {
+            cell[width] = v[k];
+        }
+    }
+
+}
+
+// AVX2 ------------------------------------------
+
+/**
+ * @brief x / precision10_value rounded down for x = s * q, s and q below 2^31 and given
+ *        as integers and doubles.
+ *
+ * <p> The double estimate is off by less than 1, the exact remainder corrects it. </p>
+ *
+ */
+__attribute__((target("avx2"))) inline __m256i _edge_div_avx2(__m256i x, __m256d s_d, __m256d q_d) {
+
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0); // 2^52, adding it puts an integer below 2^52 in the low bits
+    const __m256i p = _mm256_set1_epi64x(precision10_value);
+
+    __m256d est = _mm256_mul_pd(_mm256_mul_pd(s_d, q_d), _mm256_set1_pd(1.0 / precision10_value));
+    est = _mm256_round_pd(est, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256i quot = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(est, magic)), _mm256_castpd_si256(magic));
+
+    const __m256i rem = _mm256_sub_epi64(x, _mm256_mul_epu32(quot, p));
+    quot = _mm256_add_epi64(quot, _mm256_cmpgt_epi64(_mm256_setzero_si256(), rem)); // rem < 0, -1
+    quot = _mm256_sub_epi64(quot, _mm256_cmpgt_epi64(rem, _mm256_sub_epi64(p, _mm256_set1_epi64x(1)))); // rem >= p, +1
+
+    return quot;
+
+}
+
+__attribute__((target("avx2"))) void _edge_band_avx2(double* rows, coord_ty end, size_t row, size_t first, size_t last) {
+
+    constexpr size_t band = 4;
+    const auto width = static_cast<_std size_t>(end.first);
+    const auto stride = 2 * width + 1;
+    const auto lanes = _std min(band, end.second - row + 1);
+    const double* const below = row == 0 ? nullptr : rows - stride + width;
+
+    const __m256d lane = _mm256_setr_pd(0, 1, 2, 3);
+    const __m256d num_v = _mm256_sub_pd(_mm256_set1_pd(static_cast<double>(end.second - row)), lane);
+    alignas(32) double h[band] = {};
+    alignas(32) double v[band];
+    _edge_band_left(rows, end, row, first, lanes, h);
+    __m256d left = _mm256_load_pd(h);
+    __m256d up = _mm256_setzero_pd();
+
+    for (size_t t = first; t != last + lanes - 1; ++t) {
+        __m256d from_below = _mm256_permute4x64_pd(up, _MM_SHUFFLE(2, 1, 0, 0));
+        from_below = _mm256_blend_pd(from_below, _mm256_set1_pd(below != nullptr && t < last ? below[t] : 0), 0x1);
+        const __m256d s = _mm256_add_pd(left, from_below);
+        const __m256d den = _mm256_set1_pd(static_cast<double>(end.first + end.second - row - t));
+        const __m256d num_h = _mm256_add_pd(_mm256_set1_pd(static_cast<double>(end.first - t)), lane);
+        const __m256d hv = _mm256_mul_pd(s, _mm256_div_pd(num_h, den));
+        up = _mm256_mul_pd(s, _mm256_div_pd(num_v, den));
+        left = _mm256_blendv_pd(left, hv, _mm256_cmp_pd(lane, _mm256_set1_pd(static_cast<double>(t - first)), _CMP_LE_OQ)); // rows not started keep the start
+        _mm256_store_pd(h, hv);
+        _mm256_store_pd(v, up);
+        _edge_band_store(rows, end, row, first, last, t, lanes, h, v);
+    }
+
+}
+
+__attribute__((target("avx2"))) void _edge_band_avx2(int_least64_t* rows, coord_ty end, size_t row, size_t first, size_t last) {
+
+    constexpr size_t band = 4;
+    const auto width = static_cast<_std size_t>(end.first);
+    const auto stride = 2 * width + 1;
+    const auto lanes = _std min(band, end.second - row + 1);
+    const int_least64_t* const below = row == 0 ? nullptr : rows - stride + width;
+
+    const double scale = static_cast<double>(precision10_value);
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0); // 2^52
+    const __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256d lane = _mm256_setr_pd(0, scale, 2 * scale, 3 * scale);
+    const __m256d num_v = _mm256_sub_pd(_mm256_set1_pd(scale * static_cast<double>(end.second - row)), lane);
+    alignas(32) int_least64_t h[band] = {};
+    alignas(32) int_least64_t v[band];
+    _edge_band_left(rows, end, row, first, lanes, h);
+    __m256i left = _mm256_load_si256(reinterpret_cast<const __m256i*>(h));
+    __m256i up = _mm256_setzero_si256();
+
+    for (size_t t = first; t != last + lanes - 1; ++t) {
+        __m256i from_below = _mm256_permute4x64_epi64(up, _MM_SHUFFLE(2, 1, 0, 0));
+        from_below = _mm256_blend_epi32(from_below, _mm256_set1_epi64x(below != nullptr && t < last ? below[t] : 0), 0x3);
+        const __m256i s = _mm256_add_epi64(left, from_below);
+        const __m256d s_d = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(s, _mm256_castpd_si256(magic))), magic);
+        const __m256d den = _mm256_set1_pd(static_cast<double>(end.first + end.second - row - t));
+        const __m256d num_h = _mm256_add_pd(_mm256_set1_pd(scale * static_cast<double>(end.first - t)), lane);
+
+        const __m256d qh_d = _mm256_round_pd(_mm256_div_pd(num_h, den), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        const __m256d qv_d = _mm256_round_pd(_mm256_div_pd(num_v, den), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        const __m256i qh = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(qh_d, magic)), _mm256_castpd_si256(magic));
+        const __m256i qv = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(qv_d, magic)), _mm256_castpd_si256(magic));
+
+        const __m256i hv = _edge_div_avx2(_mm256_mul_epu32(s, qh), s_d, qh_d);
+        up = _edge_div_avx2(_mm256_mul_epu32(s, qv), s_d, qv_d);
+        left = _mm256_blendv_epi8(left, hv, _mm256_cmpgt_epi64(_mm256_set1_epi64x(t - first + 1), index)); // rows not started keep the start
+        _mm256_store_si256(reinterpret_cast<__m256i*>(h), hv);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(v), up);
+        _edge_band_store(rows, end, row, first, last, t, lanes, h, v);
+    }
+
+}
+
+// AVX-512 ---------------------------------------
+
+/**
+ * @brief See \p _edge_div_avx2.
+ *
+ */
+__attribute__((target("avx512f,avx512dq"))) inline __m512i _edge_div_avx512(__m512i x, __m512d s_d, __m512d q_d) {
+
+    const __m512i p = _mm512_set1_epi64(precision10_value);
+
+    const __m512d est = _mm512_mul_pd(_mm512_mul_pd(s_d, q_d), _mm512_set1_pd(1.0 / precision10_value));
+    __m512i quot = _mm512_cvttpd_epi64(est);
+
+    const __m512i rem = _mm512_sub_epi64(x, _mm512_mul_epu32(quot, p));
+    quot = _mm512_mask_sub_epi64(quot, _mm512_cmplt_epi64_mask(rem, _mm512_setzero_si512()), quot, _mm512_set1_epi64(1));
+    quot = _mm512_mask_add_epi64(quot, _mm512_cmpge_epi64_mask(rem, p), quot, _mm512_set1_epi64(1));
+
+    return quot;
+
+}
+
+__attribute__((target("avx512f,avx512dq"))) void _edge_band_avx512(double* rows, coord_ty end, size_t row, size_t first, size_t last) {
+
+    constexpr size_t band = 8;
+    const auto width = static_cast<_std size_t>(end.first);
+    const auto stride = 2 * width + 1;
+    const auto lanes = _std min(band, end.second - row + 1);
+    const double* const below = row == 0 ? nullptr : rows - stride + width;
+
+    const __m512d lane = _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512i shift = _mm512_setr_epi64(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m512d num_v = _mm512_sub_pd(_mm512_set1_pd(static_cast<double>(end.second - row)), lane);
+    alignas(64) double h[band] = {};
+    alignas(64) double v[band];
+    _edge_band_left(rows, end, row, first, lanes, h);
+    __m512d left = _mm512_load_pd(h);
+    __m512d up = _mm512_setzero_pd();
+
+    for (size_t t = first; t != last + lanes - 1; ++t) {
+        __m512d from_below = _mm512_maskz_permutexvar_pd(0xFE, shift, up);
+        from_below = _mm512_mask_mov_pd(from_below, 0x1, _mm512_set1_pd(below != nullptr && t < last ? below[t] : 0));
+        const __m512d s = _mm512_add_pd(left, from_below);
+        const __m512d den = _mm512_set1_pd(static_cast<double>(end.first + end.second - row - t));
+        const __m512d num_h = _mm512_add_pd(_mm512_set1_pd(static_cast<double>(end.first - t)), lane);
+        const __m512d hv = _mm512_mul_pd(s, _mm512_div_pd(num_h, den));
+        up = _mm512_mul_pd(s, _mm512_div_pd(num_v, den));
+        left = _mm512_mask_mov_pd(left, t - first + 1 >= band ? 0xFF : static_cast<__mmask8>((1 << (t - first + 1)) - 1), hv); // rows not started keep the start
+        _mm512_store_pd(h, hv);
+        _mm512_store_pd(v, up);
+        _edge_band_store(rows, end, row, first, last, t, lanes, h, v);
+    }
+
+}
+
+__attribute__((target("avx512f,avx512dq"))) void _edge_band_avx512(int_least64_t* rows, coord_ty end, size_t row, size_t first, size_t last) {
+
+    constexpr size_t band = 8;
+    const auto width = static_cast<_std size_t>(end.first);
+    const auto stride = 2 * width + 1;
+    const auto lanes = _std min(band, end.second - row + 1);
+    const int_least64_t* const below = row == 0 ? nullptr : rows - stride + width;
+
+    const double scale = static_cast<double>(precision10_value);
+    const __m512d lane = _mm512_mul_pd(_mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7), _mm512_set1_pd(scale));
+    const __m512i shift = _mm512_setr_epi64(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m512d num_v = _mm512_sub_pd(_mm512_set1_pd(scale * static_cast<double>(end.second - row)), lane);
+    alignas(64) int_least64_t h[band] = {};
+    alignas(64) int_least64_t v[band];
+    _edge_band_left(rows, end, row, first, lanes, h);
+    __m512i left = _mm512_load_si512(h);
+    __m512i up = _mm512_setzero_si512();
+
+    for (size_t t = first; t != last + lanes - 1; ++t) {
+        __m512i from_below = _mm512_maskz_permutexvar_epi64(0xFE, shift, up);
+        from_below = _mm512_mask_mov_epi64(from_below, 0x1, _mm512_set1_epi64(below != nullptr && t < last ? below[t] : 0));
+        const __m512i s = _mm512_add_epi64(left, from_below);
+        const __m512d s_d = _mm512_cvtepi64_pd(s);
+        const __m512d den = _mm512_set1_pd(static_cast<double>(end.first + end.second - row - t));
+        const __m512d num_h = _mm512_add_pd(_mm512_set1_pd(scale * static_cast<double>(end.first - t)), lane);
+
+        const __m512d qh_d = _mm512_roundscale_pd(_mm512_div_pd(num_h, den), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        const __m512d qv_d = _mm512_roundscale_pd(_mm512_div_pd(num_v, den), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+
+        const __m512i hv = _edge_div_avx512(_mm512_mul_epu32(s, _mm512_cvttpd_epi64(qh_d)), s_d, qh_d);
+        up = _edge_div_avx512(_mm512_mul_epu32(s, _mm512_cvttpd_epi64(qv_d)), s_d, qv_d);
+        left = _mm512_mask_mov_epi64(left, t - first + 1 >= band ? 0xFF : static_cast<__mmask8>((1 << (t - first + 1)) - 1), hv); // rows not started keep the start
+        _mm512_store_si512(h, hv);
+        _mm512_store_si512(v, up);
+        _edge_band_store(rows, end, row, first, last, t, lanes, h, v);
+    }
+
+}
+
+#endif
+
+// dispatch --------------------------------------
+
+/**
+ * @brief Rows filled by one band at \p edge_simd.
+ *
+ */
+inline size_t _edge_band_rows() {
+
+    return edge_simd == simd_level::AVX512 ? 8 : 4;
+
+}
+
+/**
+ * @brief Fill columns [first, last) of a band of rows starting at \p row, see \p edge_simd.
+ *
+ */
+template<typename T, typename Tag>
+void _edge_band(T* rows, coord_ty end, size_t row, size_t first, size_t last, Tag tag) {
+
+#if PROB_SIMD_X86
+    switch (edge_simd) {
+        case simd_level::AVX512: return _edge_band_avx512(rows, end, row, first, last);
+        case simd_level::AVX2: return _edge_band_avx2(rows, end, row, first, last);
+        default: break;
+    }
+#endif
+
+    _edge_band_scalar(rows, end, row, first, last, _std is_same_v<Tag, INT_LEAST64> ? static_cast<double>(precision10_value) : 1.0, tag);
+
+}
+
+/**
+ * @brief Assert the band kernels are exact for \p end, see \p _edge_cell.
+ *
+ * <p> The INT_LEAST64 numerators reach precision10_value * (X + Y) and have to stay below
+ *     2^53 for the double quotients. </p>
+ *
+ */
+inline void _edge_assert_exact([[maybe_unused]] coord_ty end) {
+
+    assert(static_cast<double>(precision10_value) * static_cast<double>(end.first + end.second) < 9007199254740992.0 && "quotients need numerators below 2^53");
+
+}
+
+/**
+ * @brief Fill all edges of the edge_prob container \p res for \p end, the first element
+ *        must already be set.
+ *
+ * <p> Assume end.first > 0 && end.second > 0 </p>
+ *
+ */
+template<typename T, typename Tag>
+void _edge_fill(T* res, coord_ty end, Tag tag) {
+
+    _edge_assert_exact(end);
+
+    const auto rows = _edge_band_rows();
+    for (size_t row = 0; row <= end.second; row += rows) {
+        _edge_band(res + 1 + row * (2 * end.first + 1), end, row, 0, end.first + 1, tag);
+    }
+
+}
+
+/**
+ * @brief Rows and columns of a tile of \p _edge_fill_tiles. The rows are a multiple of
+ *        every band, a tile of doubles is 256 KB so it stays in the L2 cache.
+ *
+ */
+constexpr size_t edge_tile_rows = 64;
+constexpr size_t edge_tile_cols = 256;
+
+/**
+ * @brief \p _edge_fill on \p bigint_threads threads.
+ *
+ * <p> A tile needs the tile left of it and the tile below it, so tiles are queued on the
+ *     thread pool once both are done. The threads sweep the grid along its anti diagonals
+ *     without waiting on a whole diagonal.
+ * </p>
+ *
+ */
+template<typename T, typename Tag>
+void _edge_fill_tiles(T* res, coord_ty end, Tag tag) {
+
+    const auto tile_rows = (end.second + edge_tile_rows) / edge_tile_rows; // rows [0, Y]
+    const auto tile_cols = (end.first + edge_tile_cols) / edge_tile_cols; // columns [0, X]
+    const auto tiles = static_cast<_std size_t>(tile_rows * tile_cols);
+
+    if (bigint_threads == 1 || tiles == 1) {
+        _edge_fill(res, end, tag);
+        return;
+    }
+
+    _edge_assert_exact(end);
+
+    _std vector<_std atomic<int>> waiting(tiles); // tiles left and below which are not done
+    for (size_t i = 0; i != tile_rows; ++i) {
+        for (size_t j = 0; j != tile_cols; ++j) {
+            waiting[static_cast<_std size_t>(i * tile_cols + j)].store((i != 0) + (j != 0), _std memory_order_relaxed);
+        }
+    }
+    _std atomic<_std size_t> remaining(tiles);
+    auto& pool = _pool();
+    const auto rows = _edge_band_rows();
+
+    _std function<void(size_t, size_t)> run = [&](size_t i, size_t j) {
+        const auto first = j * edge_tile_cols;
+        const auto last = _std min(first + edge_tile_cols, end.first + 1);
+        const auto row_last = _std min((i + 1) * edge_tile_rows, end.second + 1);
+        for (auto row = i * edge_tile_rows; row < row_last; row += rows) {
+            _edge_band(res + 1 + row * (2 * end.first + 1), end, row, first, last, tag);
+        }
+
+        if (i + 1 != tile_rows && waiting[static_cast<_std size_t>((i + 1) * tile_cols + j)].fetch_sub(1, _std memory_order_acq_rel) == 1) {
+            pool.submit([&run, i, j]() { run(i + 1, j); });
+        }
+        if (j + 1 != tile_cols && waiting[static_cast<_std size_t>(i * tile_cols + j + 1)].fetch_sub(1, _std memory_order_acq_rel) == 1) {
+            pool.submit([&run, i, j]() { run(i, j + 1); });
+        }
+        remaining.fetch_sub(1, _std memory_order_release);
+    };
+
+    run(0, 0);
+    while (remaining.load(_std memory_order_acquire) != 0) {
+        if (!pool.run_one()) {
+            _std this_thread::yield();
+        }
+    }
+
+}
+
+end_probability
\ No newline at end of file
@@ -0,0 +1,77 @@
+// Author: Dennis Yakovlev
+
+// File containing tables of numbers for coordinates up to max_grid_sz. They are
+//     evaluated by the compiler, so they are in read only memory of the binary
+//     and need no populating at run time.
+
+#pragma once
+#include <array>
+#include <BigInt_fixed.h>
+#include <prob_vars.h>
+
+start_probability
+
+/**
+ * @brief Factorials of [0, 2 * max_grid_sz], k! = (k - 1)! * k.
+ * 
+ */
+constexpr fac_arr _factorial_table() {
+
+    fac_arr res{};
+    res[0] = fac_num_ty(1u, NATIVE{});
+    for (_std size_t i = 1; i != res.size(); ++i) {
+        res[i] = res[i - 1];
+        res[i] *= static_cast<_limb>(i);
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief Number of paths to every coordinate, paths to (x, y) are the paths to
+ *        (x - 1, y) plus the paths to (x, y - 1).
+ * 
+ */
+constexpr path_num_arr _path_num_table() {
+
+    path_num_arr res{};
+    for (_std size_t x = 0; x != res.size(); ++x) {
+        for (_std size_t y = 0; y != res[x].size(); ++y) {
+            if (x == 0 || y == 0) {
+                res[x][y] = path_num_ty(1u, NATIVE{});
+            } else {
+                res[x][y] = res[x - 1][y];
+                res[x][y] += res[x][y - 1];
+            }
+        }
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief factorials[k] = k! for k in [0, 2 * max_grid_sz].
+ * 
+ */
+static constexpr fac_arr factorials = _factorial_table();
+
+/**
+ * @brief path_nums[x][y] = (x + y) choose x, the number of paths to coordinate x,y
+ *        for x and y in [0, max_grid_sz].
+ * 
+ */
+static constexpr path_num_arr path_nums = _path_num_table();
+
+/**
+ * @brief Whether \p coord is in \p path_nums.
+ * 
+ */
+constexpr bool in_tables(coord_ty coord) {
+
+    return coord.first >= 0 && coord.first <= max_grid_sz && coord.second >= 0 && coord.second <= max_grid_sz;
+
+}
+
+end_probability
\ No newline at end of file
@@ -3,8 +3,13 @@
 // File containing miscellaneous members.
 
 #pragma once
+#include <algorithm>
 #include <BigInt.h>
+#include <BigInt_fixed.h>
+#include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <prob_tables.h>
 #include <prob_vars.h>
 #include <string>
 #include <type_traits>
@@ -60,23 +65,73 @@ inline size_t dist_to_sizety(Iter first, Iter last) {
 
 }
 
+/**
+ * @brief <b> Quick </b> - theta(log(leaves) * operator*). Product of all of \p leaves
+ *        multiplying neighbours so both operands stay about the same size.
+ * 
+ */
+BigUnsigned _product_tree(container_ty<BigUnsigned>* leaves) {
+
+    if (leaves->empty()) {
+        return BigUnsigned(1u, NATIVE{});
+    }
+
+    while (leaves->size() > 1) {
+        _std size_t half = 0;
+        for (_std size_t i = 0; i + 1 < leaves->size(); i += 2) {
+            (*leaves)[half++] = _std move((*leaves)[i]) * (*leaves)[i + 1];
+        }
+        if (leaves->size() % 2 != 0) {
+            (*leaves)[half++] = _std move(leaves->back());
+        }
+        leaves->resize(half);
+    }
+
+    return _std move(leaves->front());
+
+}
+
 // should not allow negative num
 /**
- * @brief Mathematical factorial of a number.
+ * @brief <b> Quick </b> - theta(log(num) * operator*). Mathematical factorial of a number.
  * 
  * <p> Assume num >= 0 </p>
+ * <p> Binary splitting. The odd parts of 2 to num are packed into single digits and
+ *     multiplied with \p _product_tree so subproducts stay balanced, then the factors
+ *     of 2 are put back with one shift.
+ * </p>
  * 
  */
 BigUnsigned factorial(size_t num) {
-    
-    BigUnsigned res("1");
-    num += 1;
 
-    while (--num > 0) { // compare to 0 to avoid new variable
-        res = res * BigUnsigned(_std to_string(num));
+    if (num < 64) { // result is a few digits, a plain loop beats building leaves
+        BigUnsigned res(1u, NATIVE{});
+        for (size_t i = 2; i <= num; ++i) {
+            res *= static_cast<_limb>(i);
+        }
+        return res;
     }
 
-    return res;
+    container_ty<BigUnsigned> leaves;
+    _limb packed = 1;
+    _std size_t twos = 0;
+
+    for (size_t i = 2; i <= num; ++i) {
+        auto odd = static_cast<_limb>(i); // num always fits in a single digit
+        const auto zeros = _limb_ctz(odd);
+        odd >>= zeros;
+        twos += zeros;
+        if (packed > BASE_MASK / odd) {
+            leaves.emplace_back(packed, NATIVE{});
+            packed = 1;
+        }
+        packed *= odd;
+    }
+    if (packed != 1) {
+        leaves.emplace_back(packed, NATIVE{});
+    }
+
+    return _product_tree(&leaves) << twos;
 
 }
 
@@ -84,11 +139,13 @@ BigUnsigned factorial(size_t num) {
  * @brief Instead of calculating factorial, lookup from table if num is
  *        in table. Otherwise calculate normally.
  * 
+ * <p> \p factorials is built by the compiler, so there is nothing to populate first. </p>
+ * 
  */
 BigUnsigned smart_factorial(size_t num) {
 
-    if (factorials_populated && num < factorials.size()) {
-        return *(advance(factorials.cbegin(), num));
+    if (num >= 0 && num < static_cast<size_t>(factorials.size())) {
+        return to_BigUnsigned(factorials[num]);
     }
 
     return factorial(num);
@@ -96,12 +153,16 @@ BigUnsigned smart_factorial(size_t num) {
 }
 
 /**
- * @brief Populate container with factorial in range [0, container size).
+ * @brief <b> Quick </b> - theta(size^2 * log(size)). Populate container with factorial
+ *        in range [0, container size).
  * 
  * <p> The distance between the iterator and starting iterator is the value
  *     of the factorial of that iterator position.
  *     <br> Ex: cont_ptr->cbeing() + 3 will have factorial value for 3.
  * </p>
+ * <p> Each entry is the previous one times its position, k! = (k - 1)! * k, a single
+ *     digit multiply instead of a new factorial.
+ * </p>
  * <p> Do not check that T is valid pointer to valid container.
  * </p>
  * <p> Container must have a value_type of BigUnsigned.
@@ -112,11 +173,196 @@ BigUnsigned smart_factorial(size_t num) {
 template<typename T, typename = _std enable_if_t<_std is_same_v<typename _std remove_pointer_t<T>::value_type, BigUnsigned>>>
 void populate_factorial(T cont_ptr) {
 
-    for (auto curr = cont_ptr->begin(); curr != cont_ptr->end(); ++curr) {
-        *curr = factorial(dist_to_sizety(cont_ptr->begin(), curr));
+    BigUnsigned curr_fac(1u, NATIVE{});
+    size_t num = 0;
+
+    for (auto curr = cont_ptr->begin(); curr != cont_ptr->end(); ++curr, ++num) {
+        if (num > 1) {
+            curr_fac *= static_cast<_limb>(num);
+        }
+        *curr = curr_fac;
+    }
+
+}
+
+/**
+ * @brief Primes up to and including \p num, sieve of Eratosthenes.
+ * 
+ * <p> Cached between calls, may contain larger primes. The reference is invalidated
+ *     by a later call with a larger \p num.
+ * </p>
+ * 
+ */
+const container_ty<size_t>& primes_upto(size_t num) {
+
+    static container_ty<size_t> primes;
+    static size_t sieved = 1; // all primes <= sieved are in primes
+
+    if (num > sieved) {
+        sieved = _std max(num, 2 * sieved); // grow geometrically to not sieve again soon
+        container_ty<bool> composite(sieved + 1, false);
+        primes.clear();
+        for (size_t i = 2; i <= sieved; ++i) {
+            if (composite[i]) {
+                continue;
+            }
+            primes.push_back(i);
+            for (size_t j = i * i; j <= sieved; j += i) {
+                composite[j] = true;
+            }
+        }
+    }
+
+    return primes;
+
+}
+
+/**
+ * @brief log(k!) for k in [0, num], the k'th element.
+ * 
+ * <p> Cached between calls like \p primes_upto, may contain more. The reference is
+ *     invalidated by a later call with a larger \p num.
+ * </p>
+ * <p> Every element is its own lgamma instead of a running sum, so the error does
+ *     not grow with k.
+ * </p>
+ * 
+ */
+const container_ty<long double>& log_factorials_upto(size_t num) {
+
+    static container_ty<long double> log_facs;
+
+    if (num >= static_cast<size_t>(log_facs.size())) {
+        const auto size = _std max(num + 1, 2 * static_cast<size_t>(log_facs.size())); // grow geometrically
+        for (auto k = static_cast<size_t>(log_facs.size()); k != size; ++k) {
+            log_facs.push_back(_std lgamma(static_cast<long double>(k + 1)));
+        }
     }
 
-    factorials_populated = true;
+    return log_facs;
+
+}
+
+/**
+ * @brief Exponent of \p prime in num!, Legendre's formula.
+ * 
+ */
+inline size_t _legendre(size_t num, size_t prime) {
+
+    size_t res = 0;
+    while (num != 0) {
+        num /= prime;
+        res += num;
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief Add \p sign times the exponent of every prime in n choose k to \p exps.
+ * 
+ * <p> exps[i] belongs to the i'th prime of \p primes_upto, and is grown as needed. </p>
+ * 
+ */
+void _binomial_exps(size_t n, size_t k, int sign, container_ty<int_least64_t>* exps) {
+
+    const auto& primes = primes_upto(n);
+
+    for (_std size_t i = 0; i != primes.size() && primes[i] <= n; ++i) {
+        const auto exp = _legendre(n, primes[i]) - _legendre(k, primes[i]) - _legendre(n - k, primes[i]);
+        if (exp == 0) {
+            continue;
+        }
+        if (exps->size() <= i) {
+            exps->resize(i + 1, 0);
+        }
+        (*exps)[i] += sign * static_cast<int_least64_t>(exp);
+    }
+
+}
+
+/**
+ * @brief Product of prime ^ (sign * exps[i]) over the primes where that exponent is positive.
+ * 
+ * <p> Prime powers are packed into single digits and then multiplied with \p _product_tree. </p>
+ * 
+ */
+BigUnsigned _prime_product(const container_ty<size_t>& primes, const container_ty<int_least64_t>& exps, int sign) {
+
+    container_ty<BigUnsigned> leaves;
+    _limb packed = 1;
+
+    for (_std size_t i = 0; i != exps.size(); ++i) {
+        const _limb prime = static_cast<_limb>(primes[i]);
+        for (auto exp = sign * exps[i]; exp > 0; --exp) {
+            if (packed > BASE_MASK / prime) {
+                leaves.emplace_back(packed, NATIVE{});
+                packed = 1;
+            }
+            packed *= prime;
+        }
+    }
+    if (packed != 1) {
+        leaves.emplace_back(packed, NATIVE{});
+    }
+
+    return _product_tree(&leaves);
+
+}
+
+/**
+ * @brief <b> Fast </b> - theta(k * N). Binomial coefficient n choose k as a \p FixedUnsigned.
+ * 
+ * <p> Multiplicative formula, C(n - k + i, i) = C(n - k + i - 1, i - 1) * (n - k + i) / i
+ *     is exact every step. Only single digit operations on inline digits, so it takes no
+ *     storage and can be evaluated at compile time. Num must hold k * C(n, k).
+ * </p>
+ * 
+ */
+template<typename Num>
+constexpr Num _binomial_fixed(size_t n, size_t k) {
+
+    if (k > n) {
+        return Num();
+    }
+
+    k = _std min(k, n - k);
+
+    Num res(1u, NATIVE{});
+    for (size_t i = 1; i <= k; ++i) {
+        res *= static_cast<_limb>(n - k + i);
+        res /= static_cast<_limb>(i);
+    }
+
+    return res;
+
+}
+
+/**
+ * @brief <b> Quick </b> - Binomial coefficient n choose k.
+ * 
+ * <p> Exponent of every prime comes from Legendre's formula and the prime powers
+ *     are multiplied with a balanced product tree, so no division is needed.
+ * </p>
+ * <p> Num is BigUnsigned or a FixedUnsigned, see \p _binomial_fixed. </p>
+ * 
+ */
+template<typename Num = BigUnsigned>
+Num binomial(size_t n, size_t k) {
+
+    if constexpr (_is_fixed_unsigned_v<Num>) {
+        return _binomial_fixed<Num>(n, k);
+    } else {
+        if (k > n) {
+            return BigUnsigned();
+        }
+
+        container_ty<int_least64_t> exps;
+        _binomial_exps(n, k, 1, &exps);
+
+        return _prime_product(primes_upto(n), exps, 1);
+    }
 
 }
 
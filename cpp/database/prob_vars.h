@@ -5,6 +5,7 @@
 #pragma once
 #include <array>
 #include <BigInt.h>
+#include <BigInt_fixed.h>
 #include <climits>
 #include <cstdint>
 #include <vector>
@@ -28,6 +29,17 @@ start_probability
     constexpr _std int_least64_t pow(_std int_least64_t base, _std int_least64_t exp) {
         return exp == 1 ? 1 : base * pow(base, exp - 1);
     }
+    /**
+     * @brief constexpr upper bound of the binary digits in num!.
+     * 
+     */
+    constexpr _std size_t factorial_bits(_std size_t num) {
+        _std size_t res = 1;
+        for (_std size_t i = 2; i <= num; ++i) {
+            res += bit_length_const(i);
+        }
+        return res;
+    }
 
     // using declerations -----------------------
     /**
@@ -78,29 +90,37 @@ start_probability
 
     // using declerations -----------------------
     using size_vec = _std vector<size_t>;
-    /**
-     * @brief factorial array
-     * 
-     */
-    using fac_arr = _std array<BigUnsigned, (2 * max_grid_sz) + 1>;
     /**
      * @brief Coordinate pair for point. First is move right and second is move up.
      *        As a result coordinates start at 0,0.
      * 
      */
     using coord_ty = _std pair<size_t, size_t>;
-
-    // variables --------------------------------
     /**
-     * @brief Factorial array.
+     * @brief Number of paths type for coordinates up to max_grid_sz, digits are inline
+     *        so it never allocates.
+     * 
+     * <p> (x + y) choose x < 2 ^ (x + y), and \p binomial multiplies by up to
+     *     max_grid_sz before dividing so it needs that many more bits.
+     * </p>
+     * 
+     */
+    using path_num_ty = FixedUnsigned<fixed_limbs(2 * max_grid_sz + bit_length_const(max_grid_sz))>;
+    /**
+     * @brief Factorial type for numbers up to 2 * max_grid_sz, digits are inline.
+     * 
+     */
+    using fac_num_ty = FixedUnsigned<fixed_limbs(factorial_bits(2 * max_grid_sz))>;
+    /**
+     * @brief factorial array, see \p factorials
      * 
      */
-    fac_arr factorials;
+    using fac_arr = _std array<fac_num_ty, (2 * max_grid_sz) + 1>;
     /**
-     * @brief true if \p factorials has been populated.
+     * @brief Number of paths array, see \p path_nums
      * 
      */
-    bool factorials_populated = false;
+    using path_num_arr = _std array<_std array<path_num_ty, max_grid_sz + 1>, max_grid_sz + 1>;
 
     // size variables ---------------------------
     static constexpr size_t size_sz = sizeof(size_t{}); // size of size type
@@ -8,6 +8,7 @@
 #include <link_chance.h>
 #include <link_edges.h>
 #include <link_paths.h>
+#include <link_stats.h>
 #include <link_vars.h>
 #include <link_info.h>
 
@@ -16,7 +17,9 @@ void Initialize(_v8 Local<_v8 Object> exports) {
     NODE_SET_METHOD(exports, "request_edges", _link get_edges_info);
     NODE_SET_METHOD(exports, "request_paths", _link get_paths_info);
     NODE_SET_METHOD(exports, "calculate_chance", _link calc_chance);
+    NODE_SET_METHOD(exports, "calculate_chance_batch", _link calc_chance_batch);
     NODE_SET_METHOD(exports, "request_info", _link get_complete_info);
+    NODE_SET_METHOD(exports, "request_alloc_stats", _link get_alloc_stats);
 
 }
 
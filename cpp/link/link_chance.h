@@ -5,11 +5,14 @@
 #include <link_vars.h>
 #include <node.h>
 #include <v8.h>
+#include <vector>
 
 start_link
 
 void calc_chance(const _v8 FunctionCallbackInfo<_v8 Value>& args) {
 
+    arena_scope scope(&_link arena_request); // numbers live until the request is done
+
     _v8 Isolate* isolate = args.GetIsolate();
     _v8 Local<_v8 Context> context = _v8 Context::New(isolate);
 
@@ -26,4 +29,85 @@ void calc_chance(const _v8 FunctionCallbackInfo<_v8 Value>& args) {
 
 }
 
+void calc_chance_batch(const _v8 FunctionCallbackInfo<_v8 Value>& args) {
+    // chance through every point of the array "points" of {x, y}, for the end x2,y2
+
+    arena_scope scope(&_link arena_request); // numbers live until the request is done
+
+    _v8 Isolate* isolate = args.GetIsolate();
+    _v8 Local<_v8 Context> context = _v8 Context::New(isolate);
+
+    // points come straight from the client, unlike calc_chance nothing checked them in js
+    const auto throw_type = [isolate](const char* msg) {
+        isolate->ThrowException(_v8 Exception::TypeError(_v8 String::NewFromUtf8(isolate, msg).ToLocalChecked()));
+    };
+    const auto throw_range = [isolate](const char* msg) {
+        isolate->ThrowException(_v8 Exception::RangeError(_v8 String::NewFromUtf8(isolate, msg).ToLocalChecked()));
+    };
+    const auto is_int = [isolate, context](_v8 Local<_v8 Object> obj, const char* key) {
+        _v8 Local<_v8 Value> val = _link _get_obj_arg(isolate, context, obj, key);
+        return !val.IsEmpty() && val->IsInt32();
+    };
+
+    if (args.Length() < 1 || !args[0]->IsObject()) {
+        throw_type("expected an object { x2, y2, points }");
+        return;
+    }
+
+    _v8 Local<_v8 Object> obj_ret = _v8 Object::New(isolate); // object to return
+    _v8 Local<_v8 Object> obj_in = args[0].As<_v8 Object>(); // object from args
+
+    if (!is_int(obj_in, "x2") || !is_int(obj_in, "y2")) {
+        throw_type("x2 and y2 must be integers");
+        return;
+    }
+    auto coord_end = _link _get_obj_coords(isolate, context, obj_in, "x2", "y2");
+    if (coord_end.first < 0 || coord_end.second < 0) {
+        throw_range("x2 and y2 must not be negative");
+        return;
+    }
+
+    _v8 Local<_v8 Value> points_val = _link _get_obj_arg(isolate, context, obj_in, "points");
+    if (points_val.IsEmpty() || !points_val->IsArray()) {
+        throw_type("points must be an array");
+        return;
+    }
+    _v8 Local<_v8 Array> points_arr = points_val.As<_v8 Array>();
+
+    _std vector<pathprob::coord_ty> points(points_arr->Length());
+    for (uint32_t i = 0; i != points_arr->Length(); ++i) {
+        _v8 Local<_v8 Value> point;
+        if (!points_arr->Get(context, i).ToLocal(&point)) {
+            return; // getter threw, the exception is already pending
+        }
+        if (!point->IsObject()) {
+            throw_type("every point must be an object { x, y }");
+            return;
+        }
+        _v8 Local<_v8 Object> point_obj = point.As<_v8 Object>();
+        if (!is_int(point_obj, "x") || !is_int(point_obj, "y")) {
+            throw_type("x and y of every point must be integers");
+            return;
+        }
+        points[i] = _link _get_obj_coords(isolate, context, point_obj, "x", "y");
+        if (points[i].first < 0 || points[i].first > coord_end.first || points[i].second < 0 || points[i].second > coord_end.second) {
+            throw_range("every point must have 0 <= x <= x2 and 0 <= y <= y2");
+            return;
+        }
+    }
+
+    auto res = _prob chance_path_batch(coord_end, points.cbegin(), points.cend());
+
+    // create chances array, same order as points
+    _v8 Local<_v8 String> chance_str = _v8 String::NewFromUtf8Literal(isolate, "chances");
+    _v8 Local<_v8 Array> chance_arr = _v8 Array::New(isolate, static_cast<int>(res.size()));
+    for (uint32_t i = 0; i != res.size(); ++i) {
+        chance_arr->Set(context, i, _v8 Number::New(isolate, res[i]));
+    }
+    obj_ret.As<_v8 Object>()->Set(context, chance_str, chance_arr);
+
+    args.GetReturnValue().Set(obj_ret);
+
+}
+
 end_link
\ No newline at end of file
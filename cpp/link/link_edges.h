@@ -28,6 +28,8 @@ void _get_edges_info(_v8 Isolate* isolate, _v8 Local<_v8 Context> context, const
 
 void get_edges_info(const _v8 FunctionCallbackInfo<_v8 Value>& args) {
 
+    arena_scope scope(&_link arena_request); // numbers live until the request is done
+
     _v8 Isolate* isolate = args.GetIsolate();
     _v8 Local<_v8 Context> context = _v8 Context::New(isolate);
 
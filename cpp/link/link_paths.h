@@ -15,11 +15,7 @@ void _get_paths_info( _v8 Isolate* isolate, _v8 Local<_v8 Context> context, cons
     auto res = _link _read_map(coord);
 
     _v8 Local<_v8 String> path_str = _v8 String::NewFromUtf8Literal(isolate, "paths");
-    auto num_10 = BigUnsigned_10(res.first);
-    _std string num_str_10;
-    for (auto i : num_10) {
-        num_str_10.push_back('0' + i);
-    }
+    auto num_str_10 = BigUnsigned_10_str(res.first);
     _v8 Local<_v8 String> path_str_val;
     _v8 String::NewFromUtf8(isolate, num_str_10.c_str()).ToLocal(&path_str_val);
 
@@ -29,6 +25,8 @@ void _get_paths_info( _v8 Isolate* isolate, _v8 Local<_v8 Context> context, cons
 
 void get_paths_info(const _v8 FunctionCallbackInfo<_v8 Value>& args) {
 
+    arena_scope scope(&_link arena_request); // numbers live until the request is done
+
     _v8 Isolate* isolate = args.GetIsolate();
     _v8 Local<_v8 Context> context = _v8 Context::New(isolate);
 
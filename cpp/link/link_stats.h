@@ -0,0 +1,30 @@
+// Author: Dennis Yakovlev
+
+#pragma once
+#include <link_utils.h>
+#include <link_vars.h>
+#include <node.h>
+#include <v8.h>
+
+start_link
+
+void get_alloc_stats(const _v8 FunctionCallbackInfo<_v8 Value>& args) {
+    // digit storage counters of the last finished request, see alloc_stats
+
+    _v8 Isolate* isolate = args.GetIsolate();
+    _v8 Local<_v8 Context> context = _v8 Context::New(isolate);
+
+    _v8 Local<_v8 Object> obj_ret = _v8 Object::New(isolate); // object to return
+
+    const auto stats = _link arena_request.last_stats();
+    _link _set_obj_arg_num(isolate, context, obj_ret, "requested", static_cast<double>(stats.requested));
+    _link _set_obj_arg_num(isolate, context, obj_ret, "inlined", static_cast<double>(stats.inlined));
+    _link _set_obj_arg_num(isolate, context, obj_ret, "arena", static_cast<double>(stats.arena));
+    _link _set_obj_arg_num(isolate, context, obj_ret, "heap", static_cast<double>(stats.heap));
+    _link _set_obj_arg_num(isolate, context, obj_ret, "saved", static_cast<double>(stats.saved()));
+
+    args.GetReturnValue().Set(obj_ret);
+
+}
+
+end_link
\ No newline at end of file
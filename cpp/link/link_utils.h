@@ -95,7 +95,7 @@ void _set_obj_arg_num(_v8 Isolate* isolate, _v8 Local<_v8 Context> context, _v8
 
 auto _read_map(const pathprob::coord_ty& coord) {
 
-    return pathprob::read_map("map.bin", "info.bin", coord, pathprob::DOUBLE{});
+    return pathprob::read_map<pathprob::path_num_ty>("map.bin", "info.bin", coord, pathprob::DOUBLE{});
 
 }
 
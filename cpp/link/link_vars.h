@@ -40,4 +40,12 @@ _v8 Isolate* isolate_edge;
 bool init_edge = true;
 bool init_path = true;
 
+// All below are related to memory of BigUnsigned
+
+/**
+ * @brief Arena for numbers of a single request, see arena_scope.
+ * 
+ */
+request_arena arena_request;
+
 end_link
\ No newline at end of file
@@ -21,7 +21,7 @@ void create_files() {
 
     cout << "\n\nHashed Size: " << hashed.size() << "\n\n";  // print number of elements in hashed container
 
-    auto result_vec = write_info("info.bin", hashed); // write out information to file which stores info
+    auto result_vec = write_info<path_num_ty>("info.bin", hashed); // write out information to file which stores info
 
     copy(result_vec.cbegin(), result_vec.cend(), ostream_iterator<IndexInfo>(cout, "\n")); // print out written information
 
@@ -33,7 +33,7 @@ void create_files() {
 
 void read_coord(pathprob::size_t x, pathprob::size_t y) {
 
-    auto res_pair = read_map("map.bin", "info.bin", coord_ty(x,y), DOUBLE{});
+    auto res_pair = read_map<path_num_ty>("map.bin", "info.bin", coord_ty(x,y), DOUBLE{});
     cout << setprecision(precision10_digits) << res_pair.first << endl;
     copy(++res_pair.second.cbegin(), res_pair.second.cend(), ostream_iterator<int_least64_t>(cout, ", ")); // print edges prob
     cout << endl;